@@ -0,0 +1,79 @@
+#pragma once
+#include <string>
+#include "arena/arena_constants.hpp"
+
+// The 'arena' namespace is used to organize all the components of the bot-vs-bot evaluation.
+namespace arena
+{
+
+    // The playing algorithms an arena engine can use.
+    enum class EngineType
+    {
+        RANDOM,
+        MINMAX,
+        MCTS,
+        IRIS_ZERO,
+        IRIS_ZERO_GUMBEL
+    };
+
+    // Configuration of an arena engine: its algorithm and the parameters the algorithm uses.
+    struct EngineConfig
+    {
+        EngineType type = EngineType::RANDOM;
+
+        // Depth of the minmax search.
+        int depth = 3;
+
+        // Number of simulations per move of the MCTS and IrisZero searches.
+        int nb_simulations = 400;
+
+        // Model of the IrisZero searches, loaded once per arena and shared by all its games.
+        std::string model_path = "";
+    };
+
+    // Configuration of the sequential probability ratio test stopping the arena early: the test decides between the
+    // first engine being 'elo0' stronger than the second one, and being 'elo1' stronger, with the error rates 'alpha'
+    // and 'beta'.
+    struct SprtConfig
+    {
+        bool enabled = false;
+        float elo0 = 0.0;
+        float elo1 = 10.0;
+        float alpha = SPRT_ALPHA;
+        float beta = SPRT_BETA;
+    };
+
+    // Results of an arena, counted for the first engine.
+    struct ArenaResult
+    {
+        int nb_games;
+        int wins;
+        int draws;
+        int losses;
+
+        // Average score per game (1 for a win, 0.5 for a draw).
+        float score;
+
+        // Elo difference between the first and the second engine, and the half-width of its 95% confidence interval.
+        float elo;
+        float elo_error;
+
+        // Log-likelihood ratio of the SPRT, and its decision: 1 if the stronger hypothesis was accepted, -1 if the
+        // weaker one was accepted, 0 if the test did not stop the arena.
+        float llr;
+        int sprt_decision;
+    };
+
+    // Plays 'nb_games' games between two engines on 'nb_threads' worker threads, and returns the results of the first
+    // engine. The games are played in pairs on the same random tile layout, each engine playing yellow once, and a game
+    // is a draw after ARENA_MAX_TURNS turns. The layouts are derived from 'seed'.
+    // If the SPRT is enabled, no new game is started once it reaches a decision.
+    // Throws if the model of an IrisZero engine cannot be loaded.
+    ArenaResult play_arena(
+        const EngineConfig &first_engine,
+        const EngineConfig &second_engine,
+        int nb_games,
+        int nb_threads,
+        unsigned int seed,
+        const SprtConfig &sprt = SprtConfig());
+}
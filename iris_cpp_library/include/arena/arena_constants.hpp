@@ -0,0 +1,14 @@
+#pragma once
+
+// The 'arena' namespace is used to organize all the components of the bot-vs-bot evaluation.
+namespace arena
+{
+
+    // Max number of turns of an arena game, after which the game is a draw.
+    extern const int ARENA_MAX_TURNS;
+
+    // Default error rates of the sequential probability ratio test (SPRT): probability of accepting the stronger
+    // hypothesis when the weaker one holds (alpha), and the weaker hypothesis when the stronger one holds (beta).
+    extern const float SPRT_ALPHA;
+    extern const float SPRT_BETA;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include "arena/arena.hpp"
+#include "game/state.hpp"
+
+// The 'async_search' namespace is used to organize the searches running in the background.
+namespace async_search
+{
+
+    // The SearchHandle class runs the search of a move by an engine (see 'arena::EngineConfig') on a background thread,
+    // so that the caller can keep working while the engine thinks.
+    // The MCTS and IrisZero searches (with or without the Gumbel root search) report their current best move while they run, and stop early when asked to.
+    // The other engines only give their move once it is found.
+    // The moves are in the Python format (see 'move_to_python_format').
+    class SearchHandle
+    {
+    public:
+        // Constructor taking the position, the engine and the time limit in seconds of the MCTS and IrisZero searches
+        // (a negative 'reflexion_time' means no time limit, the search then runs the simulations of the engine).
+        // The search starts right away.
+        SearchHandle(const game::GameState &state, const arena::EngineConfig &engine, float reflexion_time);
+
+        // Stops the search and waits for the background thread.
+        ~SearchHandle();
+
+        // Returns true if the search is over.
+        bool poll() const;
+
+        // Returns the current best move, or an empty optional if the search has not reported any move yet.
+        std::optional<std::pair<int, int>> best_so_far() const;
+
+        // Asks the search to stop as soon as possible. Its move is then the best one found so far.
+        void stop();
+
+        // Blocks until the search is over, and returns its move.
+        // Rethrows the error of the search if it failed.
+        std::pair<int, int> result();
+
+    private:
+        // Function run by the background thread.
+        void run(game::GameState state, arena::EngineConfig engine, float reflexion_time);
+
+        // Flag asking the search to stop.
+        std::atomic<bool> stop_;
+
+        // Current best move, whether the search is over, and its error if it failed, protected by the mutex.
+        mutable std::mutex mutex_;
+        std::condition_variable finished_condition_;
+        std::optional<std::pair<int, int>> best_move_;
+        bool is_finished_;
+        std::exception_ptr error_;
+
+        // Thread running the search.
+        std::thread thread_;
+    };
+}
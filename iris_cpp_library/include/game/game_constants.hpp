@@ -1,30 +1,101 @@
 #pragma once
 
-#include <vector>
+#include <array>
 
 // The 'game' namespace is used to organize all game-related components.
 namespace game
 {
-    
-    // Represents an adjacency list of the graph depicting the game. Each inner vector 
-    // contains node indices representing neighbors of a node.
-    extern const std::vector<std::vector<int>> NODE_NEIGHBOURS; 
 
-    // An adjacency list representation similar to NODE_NEIGHBOURS, but the neighbors are 
-    // represented in a bit format for efficient bitwise operations. 
-    // The k-th bit of BIT_NODE_NEIGHBOURS[i] if node k is adjacent to node i.
-    extern const std::vector<int> BIT_NODE_NEIGHBOURS;          
+    // Total number of actual nodes present in the game graph.
+    constexpr int NUMBER_REAL_NODES = 21;
 
-    // Contains the degree (number of neighbors) of each node in the graph. 
-    // The index of this vector corresponds to the node index.
-    extern const std::vector<int> NODE_NEIGHBOURS_SIZE; 
+    // Maximum number of possible moves a pawn can make during a turn.
+    constexpr int MAX_MVT_PER_PAWN = 10;
 
-    // Total number of actual nodes present in the game graph.
-    extern const int NUMBER_REAL_NODES; 
+    // Maximum number of possible moves a player can make during a turn
+    constexpr int MAX_MVTS = 4 * MAX_MVT_PER_PAWN + 1;
+
+    // Represents an adjacency list of the graph depicting the game. Each inner array contains node indices
+    // representing neighbors of a node, in the order of the move indexes, padded with -1.
+    constexpr std::array<std::array<int, MAX_MVT_PER_PAWN>, NUMBER_REAL_NODES> NODE_NEIGHBOURS = {{
+        {1, 6, 2, 7, 3, 8, 4, 9, 5, 10},
+        {0, 5, 10, 11, 6, 2, -1, -1, -1, -1},
+        {0, 1, 6, 12, 7, 3, -1, -1, -1, -1},
+        {0, 2, 7, 13, 8, 4, -1, -1, -1, -1},
+        {0, 3, 8, 14, 9, 5, -1, -1, -1, -1},
+        {0, 4, 9, 15, 10, 1, -1, -1, -1, -1},
+        {0, 1, 10, 11, 16, 12, 7, 2, -1, -1},
+        {0, 2, 6, 12, 17, 13, 8, 3, -1, -1},
+        {0, 3, 7, 13, 18, 14, 9, 4, -1, -1},
+        {0, 4, 8, 14, 19, 15, 10, 5, -1, -1},
+        {0, 5, 9, 15, 20, 11, 6, 1, -1, -1},
+        {1, 10, 15, 20, 16, 12, 6, -1, -1, -1},
+        {2, 6, 11, 16, 17, 13, 7, -1, -1, -1},
+        {3, 7, 12, 17, 18, 14, 8, -1, -1, -1},
+        {4, 8, 13, 18, 19, 15, 9, -1, -1, -1},
+        {5, 9, 14, 19, 20, 11, 10, -1, -1, -1},
+        {6, 11, 12, -1, -1, -1, -1, -1, -1, -1},
+        {7, 12, 13, -1, -1, -1, -1, -1, -1, -1},
+        {8, 13, 14, -1, -1, -1, -1, -1, -1, -1},
+        {9, 14, 15, -1, -1, -1, -1, -1, -1, -1},
+        {10, 15, 11, -1, -1, -1, -1, -1, -1, -1}}};
+
+    // Computes the degree of each node from NODE_NEIGHBOURS.
+    constexpr std::array<int, NUMBER_REAL_NODES> node_neighbours_size()
+    {
+        std::array<int, NUMBER_REAL_NODES> sizes = {};
+        for (int node = 0; node < NUMBER_REAL_NODES; node++)
+        {
+            while (sizes[node] < MAX_MVT_PER_PAWN && NODE_NEIGHBOURS[node][sizes[node]] >= 0)
+            {
+                sizes[node]++;
+            }
+        }
+        return sizes;
+    }
+
+    // Contains the degree (number of neighbors) of each node in the graph.
+    // The index of this array corresponds to the node index.
+    constexpr std::array<int, NUMBER_REAL_NODES> NODE_NEIGHBOURS_SIZE = node_neighbours_size();
+
+    // Computes the bitfields of the neighbors of each node from NODE_NEIGHBOURS.
+    constexpr std::array<int, NUMBER_REAL_NODES> bit_node_neighbours()
+    {
+        std::array<int, NUMBER_REAL_NODES> bits = {};
+        for (int node = 0; node < NUMBER_REAL_NODES; node++)
+        {
+            for (int index = 0; index < NODE_NEIGHBOURS_SIZE[node]; index++)
+            {
+                bits[node] |= 1 << NODE_NEIGHBOURS[node][index];
+            }
+        }
+        return bits;
+    }
+
+    // An adjacency list representation similar to NODE_NEIGHBOURS, but the neighbors are
+    // represented in a bit format for efficient bitwise operations.
+    // The k-th bit of BIT_NODE_NEIGHBOURS[i] if node k is adjacent to node i.
+    constexpr std::array<int, NUMBER_REAL_NODES> BIT_NODE_NEIGHBOURS = bit_node_neighbours();
 
-    // Maximum number of possible moves a pawn can make during a turn.                        
-    extern const int MAX_MVT_PER_PAWN; 
+    // Computes the index of each node among the neighbors of each other node from NODE_NEIGHBOURS.
+    constexpr std::array<std::array<int, NUMBER_REAL_NODES>, NUMBER_REAL_NODES> node_neighbour_indexes()
+    {
+        std::array<std::array<int, NUMBER_REAL_NODES>, NUMBER_REAL_NODES> indexes = {};
+        for (int node = 0; node < NUMBER_REAL_NODES; node++)
+        {
+            for (int other_node = 0; other_node < NUMBER_REAL_NODES; other_node++)
+            {
+                indexes[node][other_node] = -1;
+            }
+            for (int index = 0; index < NODE_NEIGHBOURS_SIZE[node]; index++)
+            {
+                indexes[node][NODE_NEIGHBOURS[node][index]] = index;
+            }
+        }
+        return indexes;
+    }
 
-    // Maximum number of possible moves a player can make during a turn                         
-    extern const int MAX_MVTS;                                  
+    // Index of each node among the neighbors of another node, for the conversions of the moves:
+    // NODE_NEIGHBOUR_INDEXES[i][k] is the index of node k in NODE_NEIGHBOURS[i], or -1 if k is not adjacent to i.
+    constexpr std::array<std::array<int, NUMBER_REAL_NODES>, NUMBER_REAL_NODES> NODE_NEIGHBOUR_INDEXES = node_neighbour_indexes();
 }
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <random>
+#include <vector>
+#include "state.hpp"
+
+// The 'game' namespace is used to organize all game-related components.
+namespace game
+{
+
+    // Number of tile types: yellow-black, yellow-white, red-black, red-white and yellow-red (in this order, as in
+    // 'generate_random_board' of the Python game).
+    const int NUMBER_TILE_TYPES = 5;
+
+    // Number of orders of the tile types on a ring of five nodes.
+    const int NUMBER_RING_LAYOUTS = 120;
+
+    // Number of tile layouts of the initial board: each of the four rings of five nodes (nodes 5 * i + 1 to
+    // 5 * i + 5) holds one tile of each type.
+    const int NUMBER_LAYOUTS = NUMBER_RING_LAYOUTS * NUMBER_RING_LAYOUTS * NUMBER_RING_LAYOUTS * NUMBER_RING_LAYOUTS;
+
+    // Returns the initial game state with a given tile layout: yellow to play, every pawn on the central node, and no
+    // neutral pawn used yet.
+    // A layout is an index in [0, NUMBER_LAYOUTS): ((p0 * 120 + p1) * 120 + p2) * 120 + p3, where p_i is the index,
+    // in lexicographic order, of the order of the tile types on the i-th ring.
+    GameState layout_initial_state(int layout);
+
+    // Returns the layout of the tiles of a game state whose rings hold one tile of each type (the inverse of
+    // 'layout_initial_state' on the tiles).
+    int initial_state_layout(const GameState &state);
+
+    // Returns an initial game state with a uniformly random tile layout.
+    GameState random_initial_state(std::mt19937 &gen);
+
+    // Returns an initial game state with a random tile layout, given by a seed.
+    GameState random_initial_state(unsigned int seed);
+
+    // Returns the distinct layouts modulo the symmetries of the rules: the initial positions of two layouts are
+    // equivalent if one is sent to the other by a board automorphism, with or without swapping the black and white
+    // pawns (the transformations used by 'canonicalize'). Each class is represented by its smallest layout, and the
+    // representatives are returned in increasing order.
+    std::vector<int> distinct_layouts();
+}
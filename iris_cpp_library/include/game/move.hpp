@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include "state.hpp"
+#include "game_constants.hpp"
+
+// The 'game' namespace is used to organize all game-related components.
+namespace game
+{
+
+    // A move, encoded on a single byte by its index in the policy (see 'MoveGenerator'): pawn * MAX_MVT_PER_PAWN + i
+    // moves the pawn (0 : current player's pawn, 1 : black pawn, 2 : white pawn, 3 : orange pawn) to its i-th
+    // neighbour, and MAX_MVTS - 1 is the no-move rule.
+    // The bots keep the moves in this format during their searches, and convert the chosen one to the Python format
+    // with 'move_to_python_format'.
+    struct Move
+    {
+        // Index of the move in the policy.
+        std::uint8_t index;
+
+        // Builds a move from its index in the policy (the no-move rule by default).
+        explicit Move(int index = MAX_MVTS - 1) : index(index) {}
+
+        // Builds the move of a pawn to its i-th neighbour.
+        Move(int pawn, int neighbour) : index(pawn * MAX_MVT_PER_PAWN + neighbour) {}
+
+        // Index of the moved pawn, 4 for the no-move rule.
+        int pawn() const { return index / MAX_MVT_PER_PAWN; }
+
+        // Index of the destination among the neighbours of the moved pawn.
+        int neighbour() const { return index % MAX_MVT_PER_PAWN; }
+
+        // Returns true if the move is the no-move rule.
+        bool is_no_move() const { return index == MAX_MVTS - 1; }
+
+        bool operator==(const Move &other) const { return index == other.index; }
+        bool operator!=(const Move &other) const { return index != other.index; }
+    };
+
+    // Returns the position of the k-th pawn the current player can move (player's pawn, black, white, orange).
+    inline int movable_pawn_position(const GameState &state, int pawn)
+    {
+        switch (pawn)
+        {
+        case 0:
+            return (state.yellow_is_playing) ? state.yellow_position : state.red_position;
+        case 1:
+            return state.black_position;
+        case 2:
+            return state.white_position;
+        default:
+            return state.orange_position;
+        }
+    }
+
+    // Converts a move played from a given game state to a format easily interoperable with Python: a pair of integers
+    // whose first element is the index of the moved pawn (0 : current player's pawn, 1 : black pawn, 2 : white pawn,
+    // 3 : orange pawn, -1 : no legal move) and the second is the chosen node's index in the game board (-1 for the
+    // no-move rule).
+    inline std::pair<int, int> move_to_python_format(const GameState &parent, Move move)
+    {
+        if (move.is_no_move())
+        {
+            return std::make_pair(-1, -1);
+        }
+        return std::make_pair(move.pawn(), NODE_NEIGHBOURS[movable_pawn_position(parent, move.pawn())][move.neighbour()]);
+    }
+
+    // Returns the index (see 'Move') of a move given in the Python format, see 'move_to_python_format'.
+    // Returns -1 if the chosen node is not a neighbour of the moved pawn. The legality of the move is not checked.
+    inline int move_from_python_format(const GameState &state, int moved_pawn, int chosen_node)
+    {
+        if (moved_pawn == -1)
+        {
+            return MAX_MVTS - 1;
+        }
+        if (moved_pawn < 0 || moved_pawn > 3 || chosen_node < 0 || chosen_node >= NUMBER_REAL_NODES)
+        {
+            return -1;
+        }
+
+        int neighbour = NODE_NEIGHBOUR_INDEXES[movable_pawn_position(state, moved_pawn)][chosen_node];
+        return (neighbour < 0) ? -1 : moved_pawn * MAX_MVT_PER_PAWN + neighbour;
+    }
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <iterator>
 #include <utility>
 #include "state.hpp"
@@ -27,8 +28,7 @@ namespace game
             using pointer = value_type *;
             using reference = value_type &;
 
-            // Constructor that initializes the iterator with a game state and a starting position
-            // for checking validity of following moves
+            // Constructor that initializes the iterator with a game state and the index of the first move to generate.
             iterator(const GameState &parent, int index);
 
             // Classical C++ iterator methods
@@ -40,22 +40,20 @@ namespace game
             bool operator!=(const iterator &rhs) const;
 
         private:
-            // Advances to the next valid move, skipping any invalid moves based on the game rules.
+            // Advances to the next valid move, given by the legal moves mask.
             void next_valid_move();
 
             // Reference to the game state from which moves are being generated.
             const GameState &parent_;
 
-            // Current position within the sequence of all possible moves.
+            // Index of the current move, MAX_MVTS once all the moves have been generated.
             int index_;
 
-            // Flag indicating whether a valid move exists.
-            bool exists_valid_move_;
+            // Legal moves not generated yet, as a bitmask of their indexes (see 'legal_moves_mask').
+            std::uint64_t remaining_moves_;
 
-            // Flags indicating whether the player has the right to play the corresponding neutral pawn.
-            bool has_right_to_play_black_;
-            bool has_right_to_play_white_;
-            bool has_right_to_play_orange_;
+            // Rules applying the moves of the side to move, chosen once for all the moves of the game state.
+            GameState (*apply_move_)(const GameState &, int);
 
             // Current move index and resulting game state pair that the iterator points to.
             value_type current_;
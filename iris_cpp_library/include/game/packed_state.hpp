@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "state.hpp"
+
+// The 'game' namespace is used to organize all game-related components.
+namespace game
+{
+
+    // Size in bytes of a packed game state.
+    const int PACKED_STATE_SIZE = 12;
+
+    // A GameState packed in 95 bits, for storage. From the lowest bit:
+    // - 1 bit for the player's turn,
+    // - 5 bits for the position of each pawn (yellow, red, black, white, orange),
+    // - 3 bits for the tile of each node from 1 to 20 (node 0 never holds a tile): 0 for no tile, then 1 to 5 for
+    //   the tile types yellow-red, yellow-black, yellow-white, red-black and red-white,
+    // - 1 bit for the last use of each neutral pawn (black, white, orange),
+    // - 2 bits for the consecutive uses of each neutral pawn.
+    struct PackedGameState
+    {
+        std::uint8_t bytes[PACKED_STATE_SIZE];
+    };
+
+    // Compares two packed game states, which are equal if and only if their game states are equal.
+    inline bool operator==(const PackedGameState &lhs, const PackedGameState &rhs)
+    {
+        return std::memcmp(lhs.bytes, rhs.bytes, PACKED_STATE_SIZE) == 0;
+    }
+
+    // Hashes a packed game state, mixing all its bits (for hash tables indexed by the lowest bits).
+    inline std::uint64_t packed_game_state_hash(const PackedGameState &packed)
+    {
+        std::uint64_t words[2] = {0, 0};
+        std::memcpy(words, packed.bytes, PACKED_STATE_SIZE);
+
+        std::uint64_t hash = words[0] ^ (words[1] * 0x9E3779B97F4A7C15ULL);
+        hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+        return hash ^ (hash >> 31);
+    }
+
+    // Spreads the bits of nodes 1 to 20 of a bitfield of nodes to every third bit: node k goes to bit 3 * (k - 1).
+    inline std::uint64_t spread_node_bits(int bits)
+    {
+        // Spread of each value of 7 bits, built on first use.
+        static const std::vector<std::uint32_t> SPREAD = []
+        {
+            std::vector<std::uint32_t> table(128, 0);
+            for (int value = 0; value < 128; value++)
+            {
+                for (int k = 0; k < 7; k++)
+                {
+                    table[value] |= ((value >> k) & 1) << (3 * k);
+                }
+            }
+            return table;
+        }();
+
+        return std::uint64_t(SPREAD[(bits >> 1) & 127]) |
+               (std::uint64_t(SPREAD[(bits >> 8) & 127]) << 21) |
+               (std::uint64_t(SPREAD[(bits >> 15) & 63]) << 42);
+    }
+
+    // Packs a game state, see 'PackedGameState'.
+    // The fields are placed with constant shifts: the 60 bits of tiles start at bit 26, and the neutral pawn usage at
+    // bit 86 (bit 22 of the second word).
+    inline PackedGameState pack_game_state(const GameState &state)
+    {
+        // Each bit of the tile types (yr = 1, yb = 2, yw = 3, rb = 4, rw = 5), computed for all the nodes at once,
+        // as a tile always holds exactly two colours.
+        int black_or_white = state.black_colors | state.white_colors;
+        int type_bit0 = (state.yellow_colors & state.red_colors) | (state.yellow_colors & state.white_colors) | (state.red_colors & state.white_colors);
+        int type_bit1 = state.yellow_colors & black_or_white;
+        int type_bit2 = state.red_colors & black_or_white;
+        std::uint64_t tiles = spread_node_bits(type_bit0) | (spread_node_bits(type_bit1) << 1) | (spread_node_bits(type_bit2) << 2);
+
+        std::uint64_t words[2];
+        words[0] = std::uint64_t(state.yellow_is_playing) |
+                   (std::uint64_t(state.yellow_position) << 1) |
+                   (std::uint64_t(state.red_position) << 6) |
+                   (std::uint64_t(state.black_position) << 11) |
+                   (std::uint64_t(state.white_position) << 16) |
+                   (std::uint64_t(state.orange_position) << 21) |
+                   (tiles << 26);
+        words[1] = (tiles >> 38) |
+                   (std::uint64_t(state.black_last_use) << 22) |
+                   (std::uint64_t(state.white_last_use) << 23) |
+                   (std::uint64_t(state.orange_last_use) << 24) |
+                   (std::uint64_t(state.black_consecutive_last_use) << 25) |
+                   (std::uint64_t(state.white_consecutive_last_use) << 27) |
+                   (std::uint64_t(state.orange_consecutive_last_use) << 29);
+
+        PackedGameState packed;
+        std::memcpy(packed.bytes, words, PACKED_STATE_SIZE);
+        return packed;
+    }
+
+    // Unpacks a game state packed by 'pack_game_state'.
+    inline GameState unpack_game_state(const PackedGameState &packed)
+    {
+        std::uint64_t words[2] = {0, 0};
+        std::memcpy(words, packed.bytes, PACKED_STATE_SIZE);
+        int offset = 0;
+
+        // Reads the next 'nb_bits' bits.
+        auto get = [&words, &offset](int nb_bits) -> int
+        {
+            std::uint64_t value = words[offset / 64] >> (offset % 64);
+            if (offset % 64 + nb_bits > 64)
+            {
+                value |= words[offset / 64 + 1] << (64 - offset % 64);
+            }
+            offset += nb_bits;
+            return static_cast<int>(value & ((std::uint64_t(1) << nb_bits) - 1));
+        };
+
+        GameState state;
+        state.yellow_is_playing = get(1);
+        state.yellow_position = get(5);
+        state.red_position = get(5);
+        state.black_position = get(5);
+        state.white_position = get(5);
+        state.orange_position = get(5);
+
+        state.yellow_colors = 0;
+        state.red_colors = 0;
+        state.black_colors = 0;
+        state.white_colors = 0;
+        for (int node = 1; node <= 20; node++)
+        {
+            int bit = 1 << node;
+            switch (get(3))
+            {
+            case 1:
+                state.yellow_colors |= bit;
+                state.red_colors |= bit;
+                break;
+            case 2:
+                state.yellow_colors |= bit;
+                state.black_colors |= bit;
+                break;
+            case 3:
+                state.yellow_colors |= bit;
+                state.white_colors |= bit;
+                break;
+            case 4:
+                state.red_colors |= bit;
+                state.black_colors |= bit;
+                break;
+            case 5:
+                state.red_colors |= bit;
+                state.white_colors |= bit;
+                break;
+            }
+        }
+
+        state.black_last_use = get(1);
+        state.white_last_use = get(1);
+        state.orange_last_use = get(1);
+        state.black_consecutive_last_use = get(2);
+        state.white_consecutive_last_use = get(2);
+        state.orange_consecutive_last_use = get(2);
+
+        return state;
+    }
+}
@@ -1,661 +1,234 @@
 #pragma once
 
+#include <cstdint>
 #include "state.hpp"
 #include "game_constants.hpp"
+#include "move.hpp"
 
 // The 'game' namespace is used to organize all game-related components.
 namespace game
 {
 
-    // Determines if the current player is allowed to play the black pawn based on the game state.
-    // A player can move the black pawn if they were the last to do so, but less than twice in a row, 
-    // or if the pawn hasn't been moved by the other player in the previous turn.
-    inline bool can_play_black(const GameState &state)
-    {
-
-        // Identify who was the last to play the black pawn.
-        // True : yellow, false : red
-        bool is_last_black_player = (state.yellow_is_playing) ? state.black_last_use : !state.black_last_use;
-
-        // Allow the move if the current player was the last to play black and has done so less than twice consecutively,
-        // or if it has not been played by the other player in the previous turn.
-        return (is_last_black_player && state.black_consecutive_last_use < 2) || state.black_consecutive_last_use == 0;
-    }
+    // The rules are templates parametrized on the side to move and on the moved pawn, so that the compiler generates
+    // a specialized version of each of them, without branches on these. The functions taking only a game state
+    // dispatch on the side to move, and the searches choose the rules of the side to move once per node (see
+    // 'MoveGenerator').
 
-    // Determines if the current player is allowed to play the white pawn based on the game state.
-    // A player can move the white pawn if they were the last to do so, but less than twice in a row, 
-    // or if the pawn hasn't been moved by the other player in the previous turn.
-    inline bool can_play_white(const GameState &state)
+    // The pawns the current player can move, in the order of the move indexes (see 'apply_move').
+    enum class Pawn
     {
-
-        // Identify who was the last to play the white pawn.
-        // True : yellow, false : red
-        bool is_last_white_player = (state.yellow_is_playing) ? state.white_last_use : !state.white_last_use;
-
-        // Allow the move if the current player was the last to play white and has done so less than twice consecutively,
-        // or if it has not been played by the other player in the previous turn.
-        return (is_last_white_player && state.white_consecutive_last_use < 2) || state.white_consecutive_last_use == 0;
-    }
-
-    // Determines if the current player is allowed to play the orange pawn based on the game state.
-    // A player can move the orange pawn if they were the last to do so, but less than twice in a row, 
-    // or if the pawn hasn't been moved by the other player in the previous turn.
-    inline bool can_play_orange(const GameState &state)
+        PLAYER,
+        BLACK,
+        WHITE,
+        ORANGE
+    };
+
+    // Returns the position of a pawn the current player can move.
+    template <bool YELLOW_IS_PLAYING, Pawn PAWN>
+    inline int pawn_position(const GameState &state)
     {
-
-        // Identify who was the last to play the orange pawn.
-        // True : yellow, false : red
-        bool is_last_orange_player = (state.yellow_is_playing) ? state.orange_last_use : !state.orange_last_use;
-
-        // Allow the move if the current player was the last to play orange and has done so less than twice consecutively,
-        // or if it has not been played by the other player in the previous turn.
-        return (is_last_orange_player && state.orange_consecutive_last_use < 2) || state.orange_consecutive_last_use == 0;
+        if constexpr (PAWN == Pawn::PLAYER)
+            return (YELLOW_IS_PLAYING) ? state.yellow_position : state.red_position;
+        else if constexpr (PAWN == Pawn::BLACK)
+            return state.black_position;
+        else if constexpr (PAWN == Pawn::WHITE)
+            return state.white_position;
+        else
+            return state.orange_position;
     }
 
-    // Validates if the proposed move for the yellow pawn is an allowed move.
-    inline bool is_valid_move_yellow(const GameState &state, int index)
+    // Determines if the current player is allowed to play a pawn based on the game state.
+    // The player's pawn can always be played. A player can move a neutral pawn if they were the last to do so, but less
+    // than twice in a row, or if the pawn hasn't been moved by the other player in the previous turn.
+    template <bool YELLOW_IS_PLAYING, Pawn PAWN>
+    inline bool can_play(const GameState &state)
     {
-
-        // Check if the given index corresponds to a neighbor of the yellow pawn.
-        if (NODE_NEIGHBOURS_SIZE[state.yellow_position] <= index)
-            return false;
-
-        int chosen_node = NODE_NEIGHBOURS[state.yellow_position][index];
-
-        // Prevent placing two pawns on the same node, with an exception for node 0.
-        if (
-            chosen_node != 0 &&
-            (state.red_position == chosen_node ||
-             state.black_position == chosen_node ||
-             state.white_position == chosen_node ||
-             state.orange_position == chosen_node))
-            return false;
-        
-        // Ensure the move adheres to the rules regarding the connection of colors.
-        // No tile or tile with tile's corresponding pawn in the neighborhood of chosen_node.
-        if (!(
-                (1 << chosen_node) &
-                (~state.red_colors | BIT_NODE_NEIGHBOURS[state.red_position] | BIT_NODE_NEIGHBOURS[state.orange_position]) &
-                (~state.black_colors | BIT_NODE_NEIGHBOURS[state.black_position]) &
-                (~state.white_colors | BIT_NODE_NEIGHBOURS[state.white_position])))
-            return false;
-
-        return true;
+        if constexpr (PAWN == Pawn::PLAYER)
+        {
+            return true;
+        }
+        else
+        {
+            bool last_use = (PAWN == Pawn::BLACK) ? state.black_last_use : (PAWN == Pawn::WHITE) ? state.white_last_use : state.orange_last_use;
+            int consecutive_last_use = (PAWN == Pawn::BLACK)   ? state.black_consecutive_last_use
+                                       : (PAWN == Pawn::WHITE) ? state.white_consecutive_last_use
+                                                               : state.orange_consecutive_last_use;
+
+            // Allow the move if the current player was the last to play the pawn and has done so less than twice
+            // consecutively, or if it has not been played by the other player in the previous turn.
+            return (last_use == YELLOW_IS_PLAYING && consecutive_last_use < 2) || consecutive_last_use == 0;
+        }
     }
 
-    // Validates if the proposed move for the yellow pawn is an allowed move.
-    inline bool is_valid_move_red(const GameState &state, int index)
+    // Validates if the proposed move of a pawn to its index-th neighbour is an allowed move, considering the right to
+    // play this pawn has been established.
+    template <bool YELLOW_IS_PLAYING, Pawn PAWN>
+    inline bool is_valid_move(const GameState &state, int index)
     {
+        int position = pawn_position<YELLOW_IS_PLAYING, PAWN>(state);
 
-        // Check if the given index corresponds to a neighbor of the red pawn.
-        if (NODE_NEIGHBOURS_SIZE[state.red_position] <= index)
+        // Check if the given index corresponds to a neighbor of the pawn.
+        if (NODE_NEIGHBOURS_SIZE[position] <= index)
             return false;
 
-        int chosen_node = NODE_NEIGHBOURS[state.red_position][index];
+        int chosen_node = NODE_NEIGHBOURS[position][index];
 
-        // Prevent placing two pawns on the same node, with an exception for node 0.
-        if (
-            chosen_node != 0 &&
-            (state.yellow_position == chosen_node ||
-             state.black_position == chosen_node ||
-             state.white_position == chosen_node ||
-             state.orange_position == chosen_node))
-            return false;
-        
-        // Ensure the move adheres to the rules regarding the connection of colors.
-        // No tile or tile with tile's corresponding pawn in the neighborhood of chosen_node.
-        if (!(
-                (1 << chosen_node) &
-                (~state.yellow_colors | BIT_NODE_NEIGHBOURS[state.yellow_position] | BIT_NODE_NEIGHBOURS[state.orange_position]) &
-                (~state.black_colors | BIT_NODE_NEIGHBOURS[state.black_position]) &
-                (~state.white_colors | BIT_NODE_NEIGHBOURS[state.white_position])))
-            return false;
+        // Nodes holding a pawn. The chosen node is a neighbour of the moved pawn, so only the other pawns can be on it.
+        int pawns = (1 << state.yellow_position) | (1 << state.red_position) | (1 << state.black_position) |
+                    (1 << state.white_position) | (1 << state.orange_position);
 
-        return true;
+        if constexpr (PAWN == Pawn::PLAYER)
+        {
+            // Prevent placing two pawns on the same node, with an exception for node 0.
+            if (chosen_node != 0 && ((pawns >> chosen_node) & 1))
+                return false;
+
+            // Ensure the move adheres to the rules regarding the connection of colors.
+            // No tile or tile with tile's corresponding pawn in the neighborhood of chosen_node.
+            int opponent_colors = (YELLOW_IS_PLAYING) ? state.red_colors : state.yellow_colors;
+            int opponent_position = (YELLOW_IS_PLAYING) ? state.red_position : state.yellow_position;
+            return (1 << chosen_node) &
+                   (~opponent_colors | BIT_NODE_NEIGHBOURS[opponent_position] | BIT_NODE_NEIGHBOURS[state.orange_position]) &
+                   (~state.black_colors | BIT_NODE_NEIGHBOURS[state.black_position]) &
+                   (~state.white_colors | BIT_NODE_NEIGHBOURS[state.white_position]);
+        }
+        else
+        {
+            // Prevent placing two pawns on the same node and prohibit returning to node 0.
+            if (chosen_node == 0 || ((pawns >> chosen_node) & 1))
+                return false;
+
+            // The orange pawn follows the connection of the black and white colors, as the players' pawns.
+            if constexpr (PAWN == Pawn::ORANGE)
+                return (1 << chosen_node) &
+                       (~state.black_colors | BIT_NODE_NEIGHBOURS[state.black_position]) &
+                       (~state.white_colors | BIT_NODE_NEIGHBOURS[state.white_position]);
+
+            // No tile on the node for the black and white pawns.
+            return !((1 << chosen_node) & (state.yellow_colors | state.red_colors));
+        }
     }
 
-    // Validates if the proposed move for the black pawn is allowed, considering the right to play this pawn has been established.
-    inline bool is_valid_move_black(const GameState &state, int index)
+    // Returns the game state at the start of the other player's turn, before applying the move of the current player:
+    // the playing status is toggled, and the consecutive use counters of the neutral pawns played by the current
+    // player on their previous turn are reset.
+    template <bool YELLOW_IS_PLAYING>
+    inline GameState next_turn(const GameState &state)
     {
-
-        // Check if the given index corresponds to a neighbor of the black pawn.
-        if (NODE_NEIGHBOURS_SIZE[state.black_position] <= index)
-            return false;
-
-        int chosen_node = NODE_NEIGHBOURS[state.black_position][index];
-
-        // Prevent placing two pawns on the same node and prohibit returning to node 0.
-        if (chosen_node == 0 ||
-            chosen_node == state.yellow_position ||
-            chosen_node == state.red_position ||
-            chosen_node == state.white_position ||
-            chosen_node == state.orange_position)
-            return false;
-        // No tile on the node.
-        if ((1 << chosen_node) & (state.yellow_colors | state.red_colors))
-            return false;
-
-        return true;
+        GameState child = state;
+        child.yellow_is_playing = !YELLOW_IS_PLAYING;
+        child.black_consecutive_last_use = (state.black_last_use == YELLOW_IS_PLAYING) ? 0 : state.black_consecutive_last_use;
+        child.white_consecutive_last_use = (state.white_last_use == YELLOW_IS_PLAYING) ? 0 : state.white_consecutive_last_use;
+        child.orange_consecutive_last_use = (state.orange_last_use == YELLOW_IS_PLAYING) ? 0 : state.orange_consecutive_last_use;
+        return child;
     }
 
-    // Validates if the proposed move for the white pawn is allowed, considering the right to play this pawn has been established.
-    inline bool is_valid_move_white(const GameState &state, int index)
+    // Applies the legal move of a pawn to its index-th neighbour and returns the new game state.
+    template <bool YELLOW_IS_PLAYING, Pawn PAWN>
+    inline GameState apply_pawn_move(const GameState &state, int index)
     {
+        int chosen_node = NODE_NEIGHBOURS[pawn_position<YELLOW_IS_PLAYING, PAWN>(state)][index];
+        GameState child = next_turn<YELLOW_IS_PLAYING>(state);
 
-        // Check if the given index corresponds to a neighbor of the white pawn.
-        if (NODE_NEIGHBOURS_SIZE[state.white_position] <= index)
-            return false;
-
-        int chosen_node = NODE_NEIGHBOURS[state.white_position][index];
+        // Update the position of the moved pawn. A neutral pawn is now used by the current player, once more in a row.
+        if constexpr (PAWN == Pawn::PLAYER)
+        {
+            if constexpr (YELLOW_IS_PLAYING)
+                child.yellow_position = chosen_node;
+            else
+                child.red_position = chosen_node;
+        }
+        else if constexpr (PAWN == Pawn::BLACK)
+        {
+            child.black_position = chosen_node;
+            child.black_last_use = YELLOW_IS_PLAYING;
+            child.black_consecutive_last_use = state.black_consecutive_last_use + 1;
+        }
+        else if constexpr (PAWN == Pawn::WHITE)
+        {
+            child.white_position = chosen_node;
+            child.white_last_use = YELLOW_IS_PLAYING;
+            child.white_consecutive_last_use = state.white_consecutive_last_use + 1;
+        }
+        else
+        {
+            child.orange_position = chosen_node;
+            child.orange_last_use = YELLOW_IS_PLAYING;
+            child.orange_consecutive_last_use = state.orange_consecutive_last_use + 1;
+        }
 
-        // Prevent placing two pawns on the same node and prohibit returning to node 0.
-        if (chosen_node == 0 ||
-            chosen_node == state.yellow_position ||
-            chosen_node == state.red_position ||
-            chosen_node == state.black_position ||
-            chosen_node == state.orange_position)
-            return false;
-        // No tile on the node.
-        if ((1 << chosen_node) & (state.yellow_colors | state.red_colors))
-            return false;
+        // The players' pawns and the orange pawn remove the tile on the chosen node if any.
+        if constexpr (PAWN == Pawn::PLAYER || PAWN == Pawn::ORANGE)
+        {
+            int mask = ~(1 << chosen_node);
+            child.yellow_colors &= mask;
+            child.red_colors &= mask;
+            child.black_colors &= mask;
+            child.white_colors &= mask;
+        }
 
-        return true;
+        return child;
     }
 
-    // Validates if the proposed move for the orange pawn is allowed, considering the right to play this pawn has been established.
-    inline bool is_valid_move_orange(const GameState &state, int index)
+    // This function handles the scenario when the current player cannot make any legal moves: their pawn is put on the
+    // central node.
+    template <bool YELLOW_IS_PLAYING>
+    inline GameState no_move(const GameState &state)
     {
-
-        // Check if the given index corresponds to a neighbor of the orange pawn.
-        if (NODE_NEIGHBOURS_SIZE[state.orange_position] <= index)
-            return false;
-
-        int chosen_node = NODE_NEIGHBOURS[state.orange_position][index];
-
-        // Prevent placing two pawns on the same node and prohibit returning to node 0.
-        if (chosen_node == 0 ||
-            chosen_node == state.yellow_position ||
-            chosen_node == state.red_position ||
-            chosen_node == state.black_position ||
-            chosen_node == state.white_position)
-            return false;
-        
-        // Ensure the move adheres to the rules regarding the connection of colors.
-        // No tile or tile with tile's corresponding pawn in the neighborhood of chosen_node.
-        if (!(
-                (1 << chosen_node) &
-                (~state.black_colors | BIT_NODE_NEIGHBOURS[state.black_position]) &
-                (~state.white_colors | BIT_NODE_NEIGHBOURS[state.white_position])))
-            return false;
-
-        return true;
+        GameState child = next_turn<YELLOW_IS_PLAYING>(state);
+        if constexpr (YELLOW_IS_PLAYING)
+            child.yellow_position = 0;
+        else
+            child.red_position = 0;
+        return child;
     }
 
-    // Applies the legal move for the yellow pawn and returns the new game state.
-    inline GameState apply_move_yellow(const GameState &state, int index)
+    // Returns the legal moves of a pawn as a bitmask of the move indexes (see 'legal_moves_mask').
+    template <bool YELLOW_IS_PLAYING, Pawn PAWN>
+    inline std::uint64_t pawn_moves_mask(const GameState &state)
     {
-        int chosen_node = NODE_NEIGHBOURS[state.yellow_position][index];
-
-        // Declaring variables to hold the parameters for the new state after the move.
-        bool new_yellow_is_playing;
-        int new_yellow_position;
-        int new_red_position;
-        int new_black_position;
-        int new_white_position;
-        int new_orange_position;
-        int new_yellow_colors;
-        int new_red_colors;
-        int new_black_colors;
-        int new_white_colors;
-        bool new_black_last_use;
-        bool new_white_last_use;
-        bool new_orange_last_use;
-        int new_black_consecutive_last_use;
-        int new_white_consecutive_last_use;
-        int new_orange_consecutive_last_use;
-
-        // It's now the other player's turn, toggle the playing status.
-        new_yellow_is_playing = !state.yellow_is_playing;
-
-        // Update positions: yellow pawn moves to chosen_node; other pawns' positions remain unchanged.
-        new_yellow_position = chosen_node;                                     
-        new_red_position = state.red_position;
-        new_black_position = state.black_position;
-        new_white_position = state.white_position;
-        new_orange_position = state.orange_position;
-
-        // Update the color states by removing the tile on the chosen node if any.
-        int mask = (~(1 << chosen_node));
-        new_yellow_colors = mask & state.yellow_colors;
-        new_red_colors = mask & state.red_colors;
-        new_black_colors = mask & state.black_colors;
-        new_white_colors = mask & state.white_colors;
-
-        // Preserve the last usage status of the neutral pawns.
-        new_black_last_use = state.black_last_use;
-        new_white_last_use = state.white_last_use;
-        new_orange_last_use = state.orange_last_use;
-
-        // Reset the consecutive last use counter for neutral pawns if they were played by yellow on his previous turn.
-        new_black_consecutive_last_use = (state.black_last_use) ? 0 : state.black_consecutive_last_use; 
-        new_white_consecutive_last_use = (state.white_last_use) ? 0 : state.white_consecutive_last_use;
-        new_orange_consecutive_last_use = (state.orange_last_use) ? 0 : state.orange_consecutive_last_use;
-
-        // Return the new game state with all the updated parameters.
-        return {
-            new_yellow_is_playing,
-            new_yellow_position,
-            new_red_position,
-            new_black_position,
-            new_white_position,
-            new_orange_position,
-            new_yellow_colors,
-            new_red_colors,
-            new_black_colors,
-            new_white_colors,
-            new_black_last_use,
-            new_white_last_use,
-            new_orange_last_use,
-            new_black_consecutive_last_use,
-            new_white_consecutive_last_use,
-            new_orange_consecutive_last_use
-        };
-    }
+        if (!can_play<YELLOW_IS_PLAYING, PAWN>(state))
+            return 0;
 
-    // Applies the legal move for the yellow pawn and returns the new game state.
-    inline GameState apply_move_red(const GameState &state, int index)
-    {
-        int chosen_node = NODE_NEIGHBOURS[state.red_position][index];
-
-        // Declaring variables to hold the parameters for the new state after the move.
-        bool new_yellow_is_playing;
-        int new_yellow_position;
-        int new_red_position;
-        int new_black_position;
-        int new_white_position;
-        int new_orange_position;
-        int new_yellow_colors;
-        int new_red_colors;
-        int new_black_colors;
-        int new_white_colors;
-        bool new_black_last_use;
-        bool new_white_last_use;
-        bool new_orange_last_use;
-        int new_black_consecutive_last_use;
-        int new_white_consecutive_last_use;
-        int new_orange_consecutive_last_use;
-
-        // It's now the other player's turn, toggle the playing status.
-        new_yellow_is_playing = !state.yellow_is_playing;
-
-        // Update positions: red pawn moves to other_node; other pawns' positions remain unchanged.
-        new_yellow_position = state.yellow_position;
-        new_red_position = chosen_node;
-        new_black_position = state.black_position;
-        new_white_position = state.white_position;
-        new_orange_position = state.orange_position;
-
-        // Update the color states by removing the tile on the chosen node if any.
-        int mask = (~(1 << chosen_node));
-        new_yellow_colors = mask & state.yellow_colors;
-        new_red_colors = mask & state.red_colors;
-        new_black_colors = mask & state.black_colors;
-        new_white_colors = mask & state.white_colors;
-
-        // Preserve the last usage status of the neutral pawns.
-        new_black_last_use = state.black_last_use;
-        new_white_last_use = state.white_last_use;
-        new_orange_last_use = state.orange_last_use;
-
-        // Reset the consecutive last use counter for neutral pawns if they were played by red on his previous turn.
-        new_black_consecutive_last_use = (!state.black_last_use) ? 0 : state.black_consecutive_last_use;
-        new_white_consecutive_last_use = (!state.white_last_use) ? 0 : state.white_consecutive_last_use; 
-        new_orange_consecutive_last_use = (!state.orange_last_use) ? 0 : state.orange_consecutive_last_use;
-
-        // Return the new game state with all the updated parameters.
-        return {
-            new_yellow_is_playing,
-            new_yellow_position,
-            new_red_position,
-            new_black_position,
-            new_white_position,
-            new_orange_position,
-            new_yellow_colors,
-            new_red_colors,
-            new_black_colors,
-            new_white_colors,
-            new_black_last_use,
-            new_white_last_use,
-            new_orange_last_use,
-            new_black_consecutive_last_use,
-            new_white_consecutive_last_use,
-            new_orange_consecutive_last_use
-        };
+        std::uint64_t mask = 0;
+        int size = NODE_NEIGHBOURS_SIZE[pawn_position<YELLOW_IS_PLAYING, PAWN>(state)];
+        for (int index = 0; index < size; index++)
+        {
+            if (is_valid_move<YELLOW_IS_PLAYING, PAWN>(state, index))
+                mask |= std::uint64_t(1) << index;
+        }
+        return mask << (static_cast<int>(PAWN) * MAX_MVT_PER_PAWN);
     }
 
-    // Applies the legal move for the black pawn and returns the new game state.
-    inline GameState apply_move_black(const GameState &state, int index)
+    // Returns the legal moves of the current player as a bitmask, see 'legal_moves_mask'.
+    template <bool YELLOW_IS_PLAYING>
+    inline std::uint64_t legal_moves_mask(const GameState &state)
     {
-        int chosen_node = NODE_NEIGHBOURS[state.black_position][index];
-
-        // Declaring variables to hold the parameters for the new state after the move.
-        bool new_yellow_is_playing;
-        int new_yellow_position;
-        int new_red_position;
-        int new_black_position;
-        int new_white_position;
-        int new_orange_position;
-        int new_yellow_colors;
-        int new_red_colors;
-        int new_black_colors;
-        int new_white_colors;
-        bool new_black_last_use;
-        bool new_white_last_use;
-        bool new_orange_last_use;
-        int new_black_consecutive_last_use;
-        int new_white_consecutive_last_use;
-        int new_orange_consecutive_last_use;
-
-        // It's now the other player's turn, toggle the playing status.
-        new_yellow_is_playing = !state.yellow_is_playing;
-
-        // Update positions: black pawn moves to other_node; other pawns' positions remain unchanged.
-        new_yellow_position = state.yellow_position;
-        new_red_position = state.red_position;
-        new_black_position = chosen_node;
-        new_white_position = state.white_position;
-        new_orange_position = state.orange_position;
-
-        // The black pawn cannot remove tiles so no update on the tiles.
-        new_yellow_colors = state.yellow_colors;
-        new_red_colors = state.red_colors;
-        new_black_colors = state.black_colors;
-        new_white_colors = state.white_colors;
-
-        // The black pawn is being played by the current player.
-        new_black_last_use = state.yellow_is_playing;
-
-        // No change in the last usage status of the white and orange pawns.
-        new_white_last_use = state.white_last_use;
-        new_orange_last_use = state.orange_last_use;
-
-        // Increase the counter for how many consecutive times the black pawn has been used.
-        new_black_consecutive_last_use = state.black_consecutive_last_use + 1;
-
-        // If the white or orange pawn was last played by the same player who just played the black pawn, 
-        // reset their consecutive usage counters. Otherwise, the counters remain unchanged.
-        new_white_consecutive_last_use =
-            (state.white_last_use == state.yellow_is_playing) ? 0 : state.white_consecutive_last_use;
-        new_orange_consecutive_last_use =
-            (state.orange_last_use == state.yellow_is_playing) ? 0 : state.orange_consecutive_last_use;
-
-        // Return the new game state with all the updated parameters.
-        return {
-            new_yellow_is_playing,
-            new_yellow_position,
-            new_red_position,
-            new_black_position,
-            new_white_position,
-            new_orange_position,
-            new_yellow_colors,
-            new_red_colors,
-            new_black_colors,
-            new_white_colors,
-            new_black_last_use,
-            new_white_last_use,
-            new_orange_last_use,
-            new_black_consecutive_last_use,
-            new_white_consecutive_last_use,
-            new_orange_consecutive_last_use
-        };
-    }
+        std::uint64_t mask = pawn_moves_mask<YELLOW_IS_PLAYING, Pawn::PLAYER>(state) |
+                             pawn_moves_mask<YELLOW_IS_PLAYING, Pawn::BLACK>(state) |
+                             pawn_moves_mask<YELLOW_IS_PLAYING, Pawn::WHITE>(state) |
+                             pawn_moves_mask<YELLOW_IS_PLAYING, Pawn::ORANGE>(state);
 
+        // No legal move: the no-move rule applies.
+        if (mask == 0)
+            mask = std::uint64_t(1) << (MAX_MVTS - 1);
 
-    // Applies the legal move for the white pawn and returns the new game state.
-    inline GameState apply_move_white(const GameState &state, int index)
-    {
-        int chosen_node = NODE_NEIGHBOURS[state.white_position][index];
-
-        // Declaring variables to hold the parameters for the new state after the move.
-        bool new_yellow_is_playing;
-        int new_yellow_position;
-        int new_red_position;
-        int new_black_position;
-        int new_white_position;
-        int new_orange_position;
-        int new_yellow_colors;
-        int new_red_colors;
-        int new_black_colors;
-        int new_white_colors;
-        bool new_black_last_use;
-        bool new_white_last_use;
-        bool new_orange_last_use;
-        int new_black_consecutive_last_use;
-        int new_white_consecutive_last_use;
-        int new_orange_consecutive_last_use;
-
-        // It's now the other player's turn, toggle the playing status.
-        new_yellow_is_playing = !state.yellow_is_playing;
-
-        // Update positions: red pawn moves to other_node; other pawns' positions remain unchanged.
-        new_yellow_position = state.yellow_position;
-        new_red_position = state.red_position;
-        new_black_position = state.black_position;
-        new_white_position = chosen_node;
-        new_orange_position = state.orange_position;
-
-        // The black pawn cannot remove tiles so no update on the tiles.
-        new_yellow_colors = state.yellow_colors;
-        new_red_colors = state.red_colors;
-        new_black_colors = state.black_colors;
-        new_white_colors = state.white_colors;
-
-        // The white pawn is being played by the current player.
-        new_white_last_use = state.yellow_is_playing;
-
-        // No change in the last usage status of the black and orange pawns.
-        new_black_last_use = state.black_last_use; 
-        new_orange_last_use = state.orange_last_use;
-
-        // Increase the counter for how many consecutive times the white pawn has been used.
-        new_white_consecutive_last_use = state.white_consecutive_last_use + 1;
-
-        // If the black or orange pawn was last played by the same player who just played the white pawn, 
-        // reset their consecutive usage counters. Otherwise, the counters remain unchanged.
-        new_black_consecutive_last_use =
-            (state.black_last_use == state.yellow_is_playing) ? 0 : state.black_consecutive_last_use; 
-        new_orange_consecutive_last_use =
-            (state.orange_last_use == state.yellow_is_playing) ? 0 : state.orange_consecutive_last_use;
-
-        // Return the new game state with all the updated parameters.
-        return {
-            new_yellow_is_playing,
-            new_yellow_position,
-            new_red_position,
-            new_black_position,
-            new_white_position,
-            new_orange_position,
-            new_yellow_colors,
-            new_red_colors,
-            new_black_colors,
-            new_white_colors,
-            new_black_last_use,
-            new_white_last_use,
-            new_orange_last_use,
-            new_black_consecutive_last_use,
-            new_white_consecutive_last_use,
-            new_orange_consecutive_last_use
-        };
+        return mask;
     }
 
-    // Applies the legal move for the orange pawn and returns the new game state.
-    inline GameState apply_move_orange(const GameState &state, int index)
-    {
-        int chosen_node = NODE_NEIGHBOURS[state.orange_position][index];
-
-        // Declaring variables to hold the parameters for the new state after the move.
-        bool new_yellow_is_playing;
-        int new_yellow_position;
-        int new_red_position;
-        int new_black_position;
-        int new_white_position;
-        int new_orange_position;
-        int new_yellow_colors;
-        int new_red_colors;
-        int new_black_colors;
-        int new_white_colors;
-        bool new_black_last_use;
-        bool new_white_last_use;
-        bool new_orange_last_use;
-        int new_black_consecutive_last_use;
-        int new_white_consecutive_last_use;
-        int new_orange_consecutive_last_use;
-
-        // It's now the other player's turn, toggle the playing status.
-        new_yellow_is_playing = !state.yellow_is_playing;
-
-        // Update positions: red pawn moves to other_node; other pawns' positions remain unchanged.
-        new_yellow_position = state.yellow_position;
-        new_red_position = state.red_position;
-        new_black_position = state.black_position;
-        new_white_position = state.white_position; 
-        new_orange_position = chosen_node;
-
-        // Update the color states by removing the tile on the chosen node if any.
-        int mask = ~(1 << chosen_node);
-        new_yellow_colors = state.yellow_colors & mask;
-        new_red_colors = state.red_colors & mask;
-        new_black_colors = state.black_colors & mask;
-        new_white_colors = state.white_colors & mask;
-
-        // The orange pawn is being played by the current player.
-        new_orange_last_use = state.yellow_is_playing;
-
-        // No change in the last usage status of the black and white pawns.
-        new_black_last_use = state.black_last_use;
-        new_white_last_use = state.white_last_use; 
-
-        // Increase the counter for how many consecutive times the orange pawn has been used.
-        new_orange_consecutive_last_use = state.orange_consecutive_last_use + 1;
-
-        // If the black or white pawn was last played by the same player who just played the orange pawn, 
-        // reset their consecutive usage counters. Otherwise, the counters remain unchanged.
-        new_black_consecutive_last_use =
-            (state.black_last_use == state.yellow_is_playing) ? 0 : state.black_consecutive_last_use; 
-        new_white_consecutive_last_use = 
-            (state.white_last_use == state.yellow_is_playing) ? 0 : state.white_consecutive_last_use; 
-
-        // Return the new game state with all the updated parameters.
-        return {
-            new_yellow_is_playing,
-            new_yellow_position,
-            new_red_position,
-            new_black_position,
-            new_white_position,
-            new_orange_position,
-            new_yellow_colors,
-            new_red_colors,
-            new_black_colors,
-            new_white_colors,
-            new_black_last_use,
-            new_white_last_use,
-            new_orange_last_use,
-            new_black_consecutive_last_use,
-            new_white_consecutive_last_use,
-            new_orange_consecutive_last_use
-        };
-    }
-
-    // This function handles the scenario when the current player cannot make any legal moves.
-    inline GameState no_move(const GameState &state)
+    // Applies a legal move of the current player, given by its index, see 'apply_move'.
+    template <bool YELLOW_IS_PLAYING>
+    inline GameState apply_move(const GameState &state, int move)
     {
-        
-        // Declaring variables to hold the parameters for the new state after applying the no-move rule.
-        bool new_yellow_is_playing;
-        int new_yellow_position;
-        int new_red_position;
-        int new_black_position;
-        int new_white_position;
-        int new_orange_position;
-        int new_yellow_colors;
-        int new_red_colors;
-        int new_black_colors;
-        int new_white_colors;
-        bool new_black_last_use;
-        bool new_white_last_use;
-        bool new_orange_last_use;
-        int new_black_consecutive_last_use;
-        int new_white_consecutive_last_use;
-        int new_orange_consecutive_last_use;
-
-        // It's now the other player's turn, toggle the playing status.
-        new_yellow_is_playing = !state.yellow_is_playing;
-
-        // Maintains the current positions of the neutral pawns as no move has been made.
-        new_black_position = state.black_position;
-        new_white_position = state.white_position;
-        new_orange_position = state.orange_position;
-
-        // Keeps the tiles unchanged.
-        new_yellow_colors = state.yellow_colors;
-        new_red_colors = state.red_colors;
-        new_black_colors = state.black_colors;
-        new_white_colors = state.white_colors;
-
-        // If the current player is yellow, put the yellow pawn on the central node and reset the consecutive use counters.
-        // Otherwise, do the same for the red player.
-        if (state.yellow_is_playing)
-        {
-            // Update pawn positions
-            new_yellow_position = 0;
-            new_red_position = state.red_position;
-
-            // Maintain the last use status of neutral pawns.
-            new_black_last_use = state.black_last_use;
-            new_white_last_use = state.white_last_use;
-            new_orange_last_use = state.orange_last_use;
-
-            // Reset the consecutive use counters for neutral pawns if they were last used by the current player.
-            new_black_consecutive_last_use = (state.black_last_use) ? 0 : state.black_consecutive_last_use;
-            new_white_consecutive_last_use = (state.white_last_use) ? 0 : state.white_consecutive_last_use;
-            new_orange_consecutive_last_use = (state.orange_last_use) ? 0 : state.orange_consecutive_last_use;
-        }
-        else
-        {
-            // Update pawn positions
-            new_yellow_position = state.yellow_position;
-            new_red_position = 0;
-
-            // Maintain the last use status of neutral pawns.
-            new_black_last_use = state.black_last_use;
-            new_white_last_use = state.white_last_use;
-            new_orange_last_use = state.orange_last_use;
-
-            // Reset the consecutive use counters for neutral pawns if they were last used by the current player.
-            new_black_consecutive_last_use = (!state.black_last_use) ? 0 : state.black_consecutive_last_use;
-            new_white_consecutive_last_use = (!state.white_last_use) ? 0 : state.white_consecutive_last_use;
-            new_orange_consecutive_last_use = (!state.orange_last_use) ? 0 : state.orange_consecutive_last_use;
-        }
-
-        // Return the new game state with all the updated parameters.
-        return {
-            new_yellow_is_playing,
-            new_yellow_position,
-            new_red_position,
-            new_black_position,
-            new_white_position,
-            new_orange_position,
-            new_yellow_colors,
-            new_red_colors,
-            new_black_colors,
-            new_white_colors,
-            new_black_last_use,
-            new_white_last_use,
-            new_orange_last_use,
-            new_black_consecutive_last_use,
-            new_white_consecutive_last_use,
-            new_orange_consecutive_last_use
-        };
+        if (move < MAX_MVT_PER_PAWN)
+            return apply_pawn_move<YELLOW_IS_PLAYING, Pawn::PLAYER>(state, move);
+        if (move < 2 * MAX_MVT_PER_PAWN)
+            return apply_pawn_move<YELLOW_IS_PLAYING, Pawn::BLACK>(state, move - MAX_MVT_PER_PAWN);
+        if (move < 3 * MAX_MVT_PER_PAWN)
+            return apply_pawn_move<YELLOW_IS_PLAYING, Pawn::WHITE>(state, move - 2 * MAX_MVT_PER_PAWN);
+        if (move < 4 * MAX_MVT_PER_PAWN)
+            return apply_pawn_move<YELLOW_IS_PLAYING, Pawn::ORANGE>(state, move - 3 * MAX_MVT_PER_PAWN);
+        return no_move<YELLOW_IS_PLAYING>(state);
     }
 
     // This function checks if there is a winner in the given state.
@@ -677,4 +250,65 @@ namespace game
             return false;
         }
     }
+
+    // Returns the winner of the given state: 1 if yellow won, -1 if red won, 0 if there is no winner yet.
+    inline int winner(const GameState &state)
+    {
+        if (16 <= state.yellow_position && state.yellow_position <= 20)
+        {
+            return 1;
+        }
+        if (16 <= state.red_position && state.red_position <= 20)
+        {
+            return -1;
+        }
+        return 0;
+    }
+
+    // Applies a legal move, given by its index in the policy (see 'MoveGenerator'), and returns the new game state.
+    // Index k * MAX_MVT_PER_PAWN + i moves the k-th pawn (player's pawn, black, white, orange) to its i-th neighbour,
+    // and the last index is the no-move rule.
+    inline GameState apply_move(const GameState &state, int move)
+    {
+        return (state.yellow_is_playing) ? apply_move<true>(state, move) : apply_move<false>(state, move);
+    }
+
+    // Applies a legal move and returns the new game state, see 'apply_move'.
+    inline GameState apply_move(const GameState &state, Move move)
+    {
+        return apply_move(state, move.index);
+    }
+
+    // Returns the legal moves of the current player as a bitmask: the k-th bit is set if the move of index k
+    // (see 'apply_move') is legal. If the player has no legal move, only the bit of the no-move rule is set.
+    // The moves are the ones generated by 'MoveGenerator', in the same order.
+    inline std::uint64_t legal_moves_mask(const GameState &state)
+    {
+        return (state.yellow_is_playing) ? legal_moves_mask<true>(state) : legal_moves_mask<false>(state);
+    }
+
+    // Returns true if the current player has a legal move, false if the no-move rule is their only choice.
+    inline bool exists_move(const GameState &state)
+    {
+        return legal_moves_mask(state) != std::uint64_t(1) << (MAX_MVTS - 1);
+    }
+
+    // Writes, for each pawn the current player can move (player's pawn, black, white, orange), the bitfield of the
+    // nodes it can legally be moved to.
+    inline void legal_destinations(const GameState &state, int destinations[4])
+    {
+        std::uint64_t mask = legal_moves_mask(state);
+        for (int pawn = 0; pawn < 4; pawn++)
+        {
+            destinations[pawn] = 0;
+            int position = movable_pawn_position(state, pawn);
+            for (int index = 0; index < NODE_NEIGHBOURS_SIZE[position]; index++)
+            {
+                if ((mask >> (pawn * MAX_MVT_PER_PAWN + index)) & 1)
+                {
+                    destinations[pawn] |= 1 << NODE_NEIGHBOURS[position][index];
+                }
+            }
+        }
+    }
 }
\ No newline at end of file
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "state.hpp"
+
+// The 'game' namespace is used to organize all game-related components.
+namespace game
+{
+
+    // Exact search of the end of the game: returns 1 if yellow can force a win within 'depth' plies (moves of either
+    // player), -1 if red can, and 0 if neither outcome is proven. A player wins by reaching the outer pentagone with
+    // their pawn, which only their own move can do, so the last ply only looks for an immediate winning move.
+    int solve(const GameState &state, int depth);
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "state.hpp"
+#include "packed_state.hpp"
+#include "game_constants.hpp"
+
+// The 'game' namespace is used to organize all game-related components.
+namespace game
+{
+
+    // Number of automorphisms of the board graph: the five rotations, each with or without a reflection.
+    const int NUMBER_BOARD_SYMMETRIES = 10;
+
+    // Number of transformations of a position preserving the rules: a board automorphism, with or without swapping
+    // the black and white pawns, and with or without swapping the players.
+    // Transformation t applies the board automorphism t % NUMBER_BOARD_SYMMETRIES, swaps the black and white pawns if
+    // (t / NUMBER_BOARD_SYMMETRIES) is odd, and swaps the players if t >= 2 * NUMBER_BOARD_SYMMETRIES.
+    // Transformation 0 is the identity.
+    const int NUMBER_SYMMETRIES = 4 * NUMBER_BOARD_SYMMETRIES;
+
+    // Number of transformations used to canonicalize a position: the board automorphisms, with or without swapping the
+    // black and white pawns (the first transformations). Swapping the players is excluded, as it changes the player's
+    // turn and the sign of the values.
+    const int NUMBER_CANONICAL_SYMMETRIES = 2 * NUMBER_BOARD_SYMMETRIES;
+
+    // The canonical representative of a position, shared by all the positions equivalent to it.
+    struct CanonicalGameState
+    {
+        // The representative and its packed form, which can be used as the key of a cache.
+        GameState state;
+        PackedGameState packed;
+
+        // Transformation sending the position to its representative.
+        int transformation;
+
+        // For each move index of the representative (see 'apply_move'), the index of the same move in the position,
+        // or -1 if the index does not correspond to a neighbour of the pawn.
+        int original_moves[MAX_MVTS];
+    };
+
+    // Returns the node a board automorphism sends 'node' to. Automorphism s rotates the board by s % 5 fifths of a
+    // turn, after a reflection if s >= 5.
+    int symmetric_node(int board_symmetry, int node);
+
+    // Returns the transformed game state. Swapping the players also changes the player's turn, so the value of the
+    // transformed state for yellow is the opposite of the one of the state.
+    GameState transform_game_state(const GameState &state, int transformation);
+
+    // Returns the index, in the policy of the transformed state, of a move of the state (see 'apply_move'):
+    // applying it to the transformed state gives the transformed child state.
+    int transform_move(const GameState &state, int move, int transformation);
+
+    // Writes the policy of the transformed state (MAX_MVTS probabilities), from the policy of the state.
+    // 'policy' and 'transformed_policy' must not overlap.
+    void transform_policy(const GameState &state, const float *policy, int transformation, float *transformed_policy);
+
+    // Returns the canonical representative of a position: among its transforms by the first
+    // NUMBER_CANONICAL_SYMMETRIES transformations, the one whose packed form is the smallest.
+    CanonicalGameState canonicalize(const GameState &state);
+}
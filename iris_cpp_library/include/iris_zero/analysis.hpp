@@ -0,0 +1,45 @@
+#pragma once
+#include <string>
+#include <utility>
+#include <vector>
+#include "game/state.hpp"
+
+// The 'iris_zero' namespace is used to organize all IrisZero related components.
+namespace iris_zero
+{
+
+    // Result of the search of a position by 'analyse_positions'. The moves are in the Python format (see
+    // 'move_to_python_format').
+    struct PositionAnalysis
+    {
+        // Move chosen by the search: the most visited one, or the one selected by sequential halving for a Gumbel search.
+        std::pair<int, int> best_move;
+
+        // Value of the position according to the search, from 1 (yellow wins) to -1 (red wins), as 'game::winner'.
+        float value;
+
+        // Distribution of the visits of the root after its first one, indexed by the moves (see 'game::legal_moves_mask').
+        // If the search did not visit any child (a Gumbel search of a single legal move), the best move gets all of it.
+        std::vector<float> visits;
+
+        // Line expected by the search: the best move, then the most visited move of each following node.
+        std::vector<std::pair<int, int>> principal_variation;
+    };
+
+    // Searches many positions with a given model, and returns their analyses in the order of the positions.
+    // Each position is searched with 'nb_simulations' simulations, without noise, with the PUCT search of
+    // 'iris_zero_bot_sim', or with the Gumbel search of 'iris_zero_bot_gumbel' if 'use_gumbel' is set.
+    // The model is loaded once. The searches run on 'nb_threads' worker threads, and their leaves are evaluated with
+    // batched forward passes of 'batch_size' positions shared by all the searches, so that the positions of a whole
+    // game are analysed in about the time of a single search.
+    // A position already won is not searched: its value is its winner, its best move is (-1, -1), and its principal
+    // variation is empty.
+    // Throws a std::runtime_error if the model cannot be loaded.
+    std::vector<PositionAnalysis> analyse_positions(
+        const std::vector<game::GameState> &states,
+        const std::string &model_path,
+        int nb_simulations,
+        bool use_gumbel,
+        int nb_threads,
+        int batch_size);
+}
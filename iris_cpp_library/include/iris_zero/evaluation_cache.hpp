@@ -0,0 +1,59 @@
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <torch/torch.h>
+#include "game/game_constants.hpp"
+#include "game/packed_state.hpp"
+#include "game/symmetry.hpp"
+#include "iris_zero/inference_server.hpp"
+
+// The 'iris_zero' namespace is used to organize all IrisZero related components.
+namespace iris_zero
+{
+
+    // The EvaluationCache class stores the evaluations of the model, keyed by the canonical representative of the
+    // positions (see 'game::canonicalize'), so that all the positions equivalent by symmetry share the same entry.
+    // The policy logits are stored in the move indexes of the representative, and mapped back to the move indexes of
+    // each position when it is found.
+    // The cache is a fixed-size table indexed by the hash of the representative: an entry replaces the one in its slot.
+    // It can be used concurrently by any number of threads.
+    class EvaluationCache
+    {
+    public:
+        // Constructor taking the number of entries.
+        explicit EvaluationCache(int nb_entries);
+
+        // Looks up the evaluation of a position, given its canonical representative. Returns true and writes the
+        // evaluation in 'evaluation' if it is found.
+        bool find(const game::CanonicalGameState &canonical, Evaluation &evaluation);
+
+        // Stores the evaluation of a position, given its canonical representative.
+        void insert(const game::CanonicalGameState &canonical, const Evaluation &evaluation);
+
+        // Fraction of the lookups that found their position.
+        float hit_rate() const;
+
+    private:
+        // An evaluation, in the move indexes of the canonical representative.
+        struct Entry
+        {
+            game::PackedGameState key;
+            bool is_valid;
+            float logits[game::MAX_MVTS];
+            float value;
+        };
+
+        // Returns the index of the slot of a representative.
+        int slot(const game::CanonicalGameState &canonical) const;
+
+        std::vector<Entry> entries_;
+
+        // Each mutex protects the slots whose index is equal to its own index modulo the number of mutexes.
+        std::vector<std::mutex> mutexes_;
+
+        // Statistics on the lookups.
+        std::atomic<long> nb_lookups_;
+        std::atomic<long> nb_hits_;
+    };
+}
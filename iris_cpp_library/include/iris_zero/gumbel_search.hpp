@@ -0,0 +1,103 @@
+#pragma once
+#include <random>
+#include <vector>
+#include <torch/torch.h>
+#include "iris_zero/inference_server.hpp"
+#include "iris_zero/iris_zero_search.hpp"
+#include "iris_zero/simulation_scheduler.hpp"
+
+// The 'iris_zero' namespace is used to organize all IrisZero related components.
+namespace iris_zero
+{
+
+    // The GumbelSearch class is a search task choosing the move at the root with Gumbel noise and sequential halving
+    // (see "Policy improvement by planning with Gumbel", Danihelka et al., 2022), which makes a good use of small
+    // simulation budgets. The root samples the 'GUMBEL_NUM_CONSIDERED_ACTIONS' best moves according to the policy
+    // perturbed by Gumbel noise, then splits the budget in phases: each phase gives the same number of simulations to
+    // every remaining move, and keeps the best half of them for the next phase. Below the root, the simulations select
+    // their leaf with the PUCT criteria, as in 'SimulationSearch'.
+    class GumbelSearch : public SearchTask
+    {
+    public:
+        // Constructor taking the root of the search, the number of simulations (the evaluation of the root included),
+        // the maximum number of suspended simulations, and the random generator of the Gumbel noise.
+        // Without noise ('add_noise' false), the search deterministically considers the moves of highest prior.
+        GumbelSearch(Node *root_node, int nb_simulations, int max_in_flight, std::mt19937 &gen, bool add_noise = true);
+
+        Node *next_leaf() override;
+        void complete(Node *leaf, const Evaluation &evaluation) override;
+        bool is_finished() const override;
+
+        // Stops the search before the end of its budget: no simulation is started anymore, and the search is finished
+        // once its suspended simulations are completed. The evaluation of the root is always completed, so that
+        // 'selected_child' ranks the moves still considered with the visits they have received.
+        void interrupt();
+
+        // Returns the child of the root chosen by the search, once it is finished.
+        Node *selected_child() const;
+
+        // Returns the improved policy of the root (MAX_MVTS probabilities), once the search is finished: the softmax of
+        // the policy logits plus the transformed completed Q-values of the moves, to be used as a training target.
+        torch::Tensor improved_policy() const;
+
+    private:
+        // Samples the Gumbel noise of the root moves, keeps the considered ones and starts the first phase.
+        void start_search();
+
+        // Sets the number of visits each considered move has to reach in the current phase.
+        void start_phase();
+
+        // Returns true if every considered move has reached its visit target (counting the suspended simulations).
+        bool phase_is_complete() const;
+
+        // Keeps the best half of the considered moves.
+        void halve();
+
+        // Mixed value estimate of the root for the player of the root: its value given by the network, mixed with the
+        // Q-values of the visited moves weighted by their priors.
+        float mixed_value() const;
+
+        // Returns the Q-value of a root child for the player of the root, or the mixed value estimate of the root
+        // if the child has not been visited.
+        float completed_q(const Node *child) const;
+
+        // Monotonic transformation of a Q-value, scaled by the visits of the most visited root child.
+        float sigma(float q) const;
+
+        // Score of the i-th root child used to rank the considered moves: Gumbel noise, logit and transformed Q-value.
+        float score(int i) const;
+
+        Node *root_node_;
+        int nb_simulations_;
+        int max_in_flight_;
+        std::mt19937 &gen_;
+        bool add_noise_;
+
+        // Number of simulations started, and number of them currently suspended.
+        int nb_launched_simulations_;
+        int nb_pending_simulations_;
+
+        // Flags indicating whether the considered moves have been sampled, and whether sequential halving is over.
+        bool is_started_;
+        bool halving_is_over_;
+
+        // Gumbel noise and log prior of each root child, in the order of the children.
+        std::vector<float> gumbel_;
+        std::vector<float> log_priors_;
+
+        // Indexes of the considered root children, and the number of visits each has to reach in the current phase.
+        std::vector<int> considered_;
+        std::vector<int> target_visits_;
+
+        // Number of phases of sequential halving, and index of the current phase.
+        int nb_phases_;
+        int phase_;
+
+        // Index in 'considered_' of the move whose subtree starts the next simulation.
+        int next_considered_;
+    };
+
+    // Runs a Gumbel search of 'nb_simulations' simulations from the root, with the leaves evaluated by the inference
+    // server, and returns the chosen child of the root.
+    Node *run_gumbel_search(Node *root_node, InferenceServer &server, int nb_simulations, int max_in_flight, std::mt19937 &gen, bool add_noise);
+}
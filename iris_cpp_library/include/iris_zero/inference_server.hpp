@@ -0,0 +1,129 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <torch/torch.h>
+#include <torch/script.h>
+#include "game/state.hpp"
+#include "game/symmetry.hpp"
+#include "iris_zero/model.hpp"
+
+// The 'iris_zero' namespace is used to organize all IrisZero related components.
+namespace iris_zero
+{
+
+    // Evaluation of a position by the model: the policy logits over moves and the value.
+    using Evaluation = std::pair<torch::Tensor, float>;
+
+    // Cache of evaluations shared by the positions equivalent by symmetry, see 'include/iris_zero/evaluation_cache.hpp'.
+    class EvaluationCache;
+
+    // The InferenceServer class runs the model on a dedicated thread. Search threads submit the positions
+    // they want evaluated and receive a future, so they can keep working on the tree while the model runs.
+    // Requests are pushed into a lock-free multiple producer / single consumer queue. The server thread
+    // forms a batch from the first pending request, and runs it when it holds 'max_batch_size' positions,
+    // or when 'max_wait' has elapsed since the first request was taken.
+    class InferenceServer
+    {
+    public:
+        // Constructor taking the loaded model, the batching policy, and the number of entries of the evaluation cache
+        // (0 disables the cache). The server thread is started right away.
+        InferenceServer(Model model, int max_batch_size, std::chrono::microseconds max_wait, int cache_size = 0);
+
+        // Evaluates the requests already submitted, and stops the server thread.
+        ~InferenceServer();
+
+        // Submits a position to be evaluated, and returns a future of its evaluation.
+        // The position is encoded by the server thread, directly into its batch buffer.
+        // This function can be called concurrently by any number of threads.
+        std::future<Evaluation> submit(const game::GameState &state);
+
+        // Submits an already encoded position (see 'encode_game_state'), which is copied into the batch buffer.
+        // The planes must stay valid until the evaluation is available.
+        std::future<Evaluation> submit(const float *planes);
+
+        // Submits an already encoded position with its game state. The evaluation is looked up in the evaluation
+        // cache first, in which case the returned future is already available.
+        std::future<Evaluation> submit(const float *planes, const game::GameState &state);
+
+        // Average number of positions per forward pass since the server started.
+        float average_batch_size() const;
+
+        // Fraction of the positions submitted with their game state that were found in the evaluation cache.
+        float cache_hit_rate() const;
+
+    private:
+        // A position waiting to be evaluated, which is also a node of the intrusive request queue.
+        struct Request
+        {
+            game::GameState state;
+            const float *planes;
+            bool use_cache;
+            game::CanonicalGameState canonical;
+            std::promise<Evaluation> promise;
+            std::atomic<Request *> next;
+        };
+
+        // Pushes a request and wakes the server thread up if needed.
+        std::future<Evaluation> submit(Request *request);
+
+        // Lock-free push, callable by any thread (Vyukov's intrusive MPSC queue).
+        void push(Request *request);
+
+        // Pops the oldest request, or returns nullptr if there is none. Only called by the server thread.
+        Request *pop();
+
+        // Blocks until a request is available and pops it. Returns nullptr if the server is stopped and no
+        // request is pending.
+        Request *wait_request();
+
+        // Runs the model on a batch of requests and fulfils their promises.
+        void evaluate_batch(std::vector<Request *> &batch);
+
+        // Function run by the server thread.
+        void serve();
+
+        // The model evaluated by the server.
+        Model model_;
+
+        // Batching policy.
+        int max_batch_size_;
+        std::chrono::microseconds max_wait_;
+
+        // Cache of the evaluations, if enabled.
+        std::unique_ptr<EvaluationCache> cache_;
+
+        // Input of the forward passes, allocated once for the largest batch. The positions of a batch are
+        // encoded in its first rows.
+        torch::Tensor batch_buffer_;
+
+        // Ends of the request queue: producers exchange the head, the server thread consumes from the tail.
+        // The stub request keeps the queue non empty, so that producers never have to touch the tail.
+        std::atomic<Request *> head_;
+        Request *tail_;
+        Request stub_;
+
+        // Flag set while the server thread is (about to be) waiting for requests, so that producers wake it up.
+        std::atomic<bool> is_sleeping_;
+
+        // Flag asking the server thread to stop.
+        std::atomic<bool> stop_;
+
+        // Mutex and condition variable only used to put the idle server thread to sleep.
+        std::mutex sleep_mutex_;
+        std::condition_variable wake_condition_;
+
+        // Statistics on the forward passes.
+        std::atomic<long> nb_batches_;
+        std::atomic<long> nb_evaluations_;
+
+        // The server thread.
+        std::thread thread_;
+    };
+}
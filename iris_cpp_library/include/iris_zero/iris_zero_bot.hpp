@@ -1,6 +1,9 @@
 #pragma once
+#include <atomic>
+#include <functional>
 #include <string>
 #include <utility>
+#include "game/state.hpp"
 
 // The 'iris_zero' namespace is used to organize all IrisZero related components.
 namespace iris_zero
@@ -51,4 +54,67 @@ namespace iris_zero
         int orange_consecutive_last_use,
         int nb_simulations,
         const std::string &model_path);
+
+    // A function returning the best move according to a model search from a given position and a given number of simulations,
+    // with the Gumbel root search (sequential halving over the best moves of the policy), suited to small simulation budgets.
+    // See include/game/state.hpp for a description of the parameters.
+    // Returns a pair of integers encoding the move played.
+    std::pair<int, int> iris_zero_bot_gumbel(
+        bool yellow_is_playing,
+        int yellow_position,
+        int red_position,
+        int black_position,
+        int white_position,
+        int orange_position,
+        int yellow_colors,
+        int red_colors,
+        int black_colors,
+        int white_colors,
+        bool black_last_use,
+        bool white_last_use,
+        bool orange_last_use,
+        int black_consecutive_last_use,
+        int white_consecutive_last_use,
+        int orange_consecutive_last_use,
+        int nb_simulations,
+        const std::string &model_path);
+
+    // Returns the best move according to a model search from a given game state and a given thinking time in seconds,
+    // see 'iris_zero_bot_time'.
+    std::pair<int, int> iris_zero_bot_time_int(const game::GameState &state, float reflexion_time, const std::string &model_path);
+
+    // Returns the best move according to a model search from a given game state and a given number of simulations,
+    // see 'iris_zero_bot_sim'.
+    std::pair<int, int> iris_zero_bot_sim_int(const game::GameState &state, int nb_simulations, const std::string &model_path);
+
+    // Returns the best move according to a model search with a Gumbel root from a given game state and a given number
+    // of simulations, see 'iris_zero_bot_gumbel'.
+    std::pair<int, int> iris_zero_bot_gumbel_int(const game::GameState &state, int nb_simulations, const std::string &model_path);
+
+    // Callback receiving the current best move of a search, in the Python format (see 'move_to_python_format').
+    using ProgressCallback = std::function<void(std::pair<int, int>)>;
+
+    // Returns the best move according to a model search from a given game state. The search runs 'nb_simulations'
+    // simulations, and stops earlier once 'reflexion_time' seconds have elapsed (a negative 'reflexion_time' means no
+    // time limit) or once 'stop' is set, which is checked every PROGRESS_INTERVAL simulations.
+    // If 'progress' is set, it receives the current best move every PROGRESS_INTERVAL simulations.
+    std::pair<int, int> iris_zero_search_int(
+        const game::GameState &state,
+        int nb_simulations,
+        float reflexion_time,
+        const std::string &model_path,
+        const std::atomic<bool> &stop,
+        const ProgressCallback &progress);
+
+    // Same as 'iris_zero_search_int', with the Gumbel root search of 'iris_zero_bot_gumbel'. The search stops earlier
+    // once 'reflexion_time' seconds have elapsed or once 'stop' is set, after the evaluation of the root, and then
+    // selects among the moves still considered by sequential halving.
+    // If 'progress' is set, it receives the move the search would select every PROGRESS_INTERVAL simulations.
+    std::pair<int, int> iris_zero_gumbel_search_int(
+        const game::GameState &state,
+        int nb_simulations,
+        float reflexion_time,
+        const std::string &model_path,
+        const std::atomic<bool> &stop,
+        const ProgressCallback &progress);
 }
\ No newline at end of file
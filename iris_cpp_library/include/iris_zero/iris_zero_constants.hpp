@@ -16,9 +16,58 @@ namespace iris_zero
      // Number of simulations per moves when generating training sample games.
     extern const int NUM_SIM_PER_MOVE;
 
+    // Probability that a move of a training sample game gets a full search of 'NUM_SIM_PER_MOVE' simulations, recorded
+    // as a training target. The other moves get a cheap search of 'NUM_FAST_SIM_PER_MOVE' simulations, not recorded.
+    extern const float PLAYOUT_CAP_FULL_SEARCH_PROBABILITY;
+    extern const int NUM_FAST_SIM_PER_MOVE;
+
+    // A search of a training sample game stops early when the visit distribution of the root changes by less than
+    // this Kullback-Leibler divergence over 'EARLY_STOP_CHECK_INTERVAL' simulations (0 disables the early stop).
+    extern const float EARLY_STOP_KL_THRESHOLD;
+    extern const int EARLY_STOP_CHECK_INTERVAL;
+
+    // A player of a training sample game resigns when the value of the searched root is beyond this threshold, in favour
+    // of the other player, for 'RESIGNATION_CONSECUTIVE_MOVES' consecutive moves (a threshold of 1 disables resignation).
+    extern const float RESIGNATION_THRESHOLD;
+    extern const int RESIGNATION_CONSECUTIVE_MOVES;
+
+    // Fraction of the training sample games played without resignation, to measure the false resignations.
+    extern const float RESIGNATION_EXEMPT_FRACTION;
+
+    // Depth (in plies) of the solver adjudicating the training sample games whose outcome is proven (0 disables it).
+    extern const int ADJUDICATION_SOLVER_DEPTH;
+
     // Number of turns before selecting greedily the next move, see AlphaZero paper.
     extern const int NUM_TURN_EXP_BEFORE_BEST; 
 
     // Number of attributes per node on the tensor representation of the game.
     extern const int NUMBER_ATRIBUTES;         
+
+    // Number of leaves a search keeps waiting for an evaluation while it selects other leaves.
+    extern const int MAX_EVALUATIONS_IN_FLIGHT;
+
+    // Same as 'MAX_EVALUATIONS_IN_FLIGHT', for each of the many searches run at the same time by the self-play engine,
+    // the reanalyse and the batch analysis (see 'run_searches'). The batches are filled by the other searches, so each
+    // search keeps fewer leaves in flight, which keeps its selection closer to a sequential search.
+    extern const int BATCH_SEARCH_EVALUATIONS_IN_FLIGHT;
+
+    // Number of simulations between two reports of the current best move of a search, see 'iris_zero_search_int'.
+    extern const int PROGRESS_INTERVAL;
+
+    // Maximum time (in microseconds) the inference server waits for a batch to fill once it holds a position.
+    extern const int INFERENCE_MAX_WAIT_MICROSECONDS;
+
+    // Number of entries of the evaluation cache of the inference server, shared by all the positions equivalent by
+    // symmetry (0 disables the cache).
+    extern const int INFERENCE_CACHE_SIZE;
+
+    // Number of simulations per move when generating training sample games with the Gumbel root search.
+    extern const int GUMBEL_NUM_SIM_PER_MOVE;
+
+    // Maximum number of moves considered at the root by the Gumbel search.
+    extern const int GUMBEL_NUM_CONSIDERED_ACTIONS;
+
+    // Parameters of the transformation of the Q-values in the Gumbel search, see Gumbel AlphaZero paper.
+    extern const float GUMBEL_C_VISIT;
+    extern const float GUMBEL_C_SCALE;
 }
\ No newline at end of file
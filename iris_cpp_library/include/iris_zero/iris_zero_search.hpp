@@ -0,0 +1,138 @@
+#pragma once
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include <torch/torch.h>
+#include <torch/script.h>
+#include "game/move.hpp"
+#include "game/state.hpp"
+#include "iris_zero/inference_server.hpp"
+#include "iris_zero/model.hpp"
+
+// The 'iris_zero' namespace is used to organize all IrisZero related components.
+namespace iris_zero
+{
+
+    // Represents a single node in the search tree of the AlphaZero MCTS algorithm.
+    struct Node
+    {
+        // The game state that this node represents.
+        game::GameState state;
+
+        // Network input of the game state (NUMBER_REAL_NODES * NUMBER_ATRIBUTES floats, see 'encode_game_state'),
+        // computed when the node is evaluated. It is derived from the parent's one, and kept for the children.
+        std::vector<float> planes;
+
+        // The move taken from the parent node to reach this current node.
+        game::Move move;
+
+        // Prior probability of the move leading to this node, given by the policy head of the network on the
+        // parent node, normalized over the legal moves of the parent.
+        float prior;
+
+        // Number of times this node has been visited.
+        int visits;
+
+        // Sum of the outputs of the values of the positions evaluated by the model in this node's subtree.
+        float wins;
+
+        // Predicted value (expected outcome) of this GameSate, as given by the neural network.
+        float value;
+
+        // Flag indicating whether this node has been expanded (i.e., all its possible children have been generated).
+        bool is_expanded;
+
+        // Flag indicating whether this node has been submitted for evaluation, and is waiting for the result.
+        bool evaluation_pending;
+
+        // Number of simulations currently waiting for an evaluation in this node's subtree. Each of them counts
+        // as a lost visit in the PUCT criteria, to steer the following selections towards other leaves.
+        int virtual_loss;
+
+        // Pointer to the parent node in the search tree.
+        Node *parent;
+
+        // List of pointers to the child nodes.
+        std::vector<Node *> children;
+
+        Node(
+            game::GameState state,
+            game::Move move = game::Move(),
+            Node *parent = nullptr) : state(state),
+                                      planes(),
+                                      move(move),
+                                      prior(0.0),
+                                      visits(0),
+                                      wins(0.0),
+                                      value(0.0),
+                                      is_expanded(false),
+                                      evaluation_pending(false),
+                                      virtual_loss(0),
+                                      parent(parent),
+                                      children() {}
+
+        ~Node()
+        {
+            for (Node *child : children)
+            {
+                delete child;
+            }
+        }
+    };
+
+    // Loads the model stored at 'model_path': weights exported for the native engine (see
+    // 'include/iris_zero/native_network.hpp'), or a TorchScript module.
+    Model load_model(const std::string &model_path);
+
+    // Evaluates the game's position using a neural network model, returning a pair of policy logits and value.
+    // Takes as input the tensor of the position to be evaluated, and the loaded model.
+    std::pair<torch::Tensor, float> position_evaluation(const torch::Tensor &state_tensor, Model model);
+
+    // Evaluates several positions with a single forward pass of the model.
+    // Returns the (policy logits, value) pairs in the order of the given position tensors.
+    std::vector<std::pair<torch::Tensor, float>> batch_position_evaluation(const std::vector<torch::Tensor> &state_tensors, Model model);
+
+    // Evaluates a batch of positions already stacked in a (batch size, NUMBER_REAL_NODES, NUMBER_ATRIBUTES) tensor.
+    std::vector<std::pair<torch::Tensor, float>> batch_position_evaluation(const torch::Tensor &states_tensor, Model model);
+
+    // Adds dirichlet noise to the priors of the children of an expanded node, to encourage exploration at the root during self-play.
+    void add_dirichlet_noise(Node *node, std::mt19937 &gen);
+
+    // Performs the selection step of the MCTS, choosing a node to be expanded based on PUCT values.
+    Node *select(Node *node);
+
+    // Expands a node by computing its value and policy according to the model,
+    // and add all possible following states to the tree if the node is not termial.
+    void expand(Node *node, Model model);
+
+    // Expands a node with an already computed model evaluation (policy logits and value).
+    // The priors of the children are the softmax of the logits over the legal moves only (see 'game::legal_moves_mask').
+    void expand(Node *node, const torch::Tensor &policy_logits, float value);
+
+    // Updates the search tree with the value computed byt the model.
+    void backpropagate(Node *node, float value);
+
+    // Adds 'count' virtual losses (removes them if negative) on the path from the node to the root.
+    void add_virtual_loss(Node *node, int count);
+
+    // Computes the network input of a node, from the one of its parent when it is available.
+    void encode_node(Node *node);
+
+    // Marks a selected leaf as waiting for its evaluation: computes its network input and adds a virtual loss on
+    // its path, so that the following selections are steered towards other leaves.
+    void begin_evaluation(Node *leaf);
+
+    // Completes the simulation of a leaf marked by 'begin_evaluation': removes the virtual loss, expands the leaf
+    // with its evaluation and backpropagates its value.
+    void complete_evaluation(Node *leaf, const Evaluation &evaluation);
+
+    // Takes a Node, and returns its policy (distribution of explored following moves) after the search.
+    torch::Tensor node_mcts_policy(Node *node);
+
+    // Takes a Node, and returns its best following move (most explored one).
+    std::pair<int, Node *> next_move_best(Node *root_node);
+
+    // Takes a Node, and returns a randomly selected following move, given the search distribution and a temperature.
+    std::pair<int, Node *> next_move_best_exp(Node *root_node, torch::Tensor root_policy, std::mt19937 &gen);
+}
@@ -1,12 +1,30 @@
 #pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
 #include <tuple>
+#include <vector>
 #include <torch/torch.h>
+#include <torch/script.h>
+#include "game/state.hpp"
+#include "iris_zero/inference_server.hpp"
 
 // The 'iris_zero' namespace is used to organize all IrisZero related components.
 namespace iris_zero
 {
 
+    // A training sample : the stacked game state representations of a self played game, the corresponding policies and values.
+    using TrainingSample = std::tuple<torch::Tensor, torch::Tensor, torch::Tensor>;
+
+    // Writer of self-play shards, see 'include/iris_zero/sample_shard.hpp'.
+    class ShardWriter;
+
     // A function returning a self played game from a position and a given model, to be used for training.
     // See include/game/state.hpp for a description of the parameters.
     // Returns a tuple of tensor : the stacked game state representations, the corresponding policies and values.
@@ -28,4 +46,106 @@ namespace iris_zero
         int white_consecutive_last_use,
         int orange_consecutive_last_use,
         const std::string &model_path);
-}
\ No newline at end of file
+
+    // Returns a self played game from a given game state and a given model, see 'generate_training_sample'.
+    std::tuple<torch::Tensor, torch::Tensor, torch::Tensor> generate_training_sample_int(const game::GameState &state, const std::string &model_path);
+
+    // The SelfPlayEngine class plays several self-play games concurrently in one process.
+    // Each worker thread advances a set of games one simulation at a time, and the leaves selected in all
+    // the games are submitted to a shared InferenceServer, which evaluates them with batched forward passes.
+    // The training samples of the finished games are made available as soon as each game is over, or appended to a
+    // shard (see 'include/iris_zero/sample_shard.hpp').
+    class SelfPlayEngine
+    {
+    public:
+        // Constructor taking the initial position of the games, the number of games to play, the model,
+        // the number of worker threads, the target number of positions per forward pass, and whether the moves are
+        // searched with the Gumbel root search ('GUMBEL_NUM_SIM_PER_MOVE' simulations) instead of PUCT ('NUM_SIM_PER_MOVE'),
+        // the path of the shard the finished games are appended to, and whether each game starts from a random initial
+        // board (see 'game::random_initial_state') instead of the given position. With a shard, the games are not
+        // returned by 'next_sample', which only waits for the end of all the games.
+        // The worker threads are started right away.
+        SelfPlayEngine(const game::GameState &initial_state, int nb_games, const std::string &model_path, int nb_threads, int batch_size, bool use_gumbel_search = false, const std::string &shard_path = "", bool random_initial_boards = false);
+
+        // Stops the games still running and waits for the worker threads.
+        ~SelfPlayEngine();
+
+        // Blocks until a game is finished, and returns its training sample.
+        // Returns an empty optional when the samples of all the games have been returned.
+        std::optional<TrainingSample> next_sample();
+
+        // Number of recorded training positions per second since the engine started.
+        float positions_per_second() const;
+
+        // Average number of positions per forward pass since the engine started.
+        float average_batch_size() const;
+
+        // Fraction of the leaf evaluations found in the evaluation cache since the engine started.
+        float cache_hit_rate() const;
+
+        // Number of games whose training sample is available or has been returned.
+        int nb_finished_games() const;
+
+        // Fraction of the games exempted from resignation that would have been resigned by the player who did not lose.
+        float false_resignation_rate() const;
+
+    private:
+        // Function run by each worker thread.
+        void worker_loop();
+
+        // Server batching the evaluations requested by the worker threads.
+        InferenceServer inference_server_;
+
+        // Initial position of every game.
+        game::GameState initial_state_;
+
+        // Total number of games to play.
+        int nb_games_;
+
+        // Flag indicating whether the moves are searched with the Gumbel root search.
+        bool use_gumbel_search_;
+
+        // Flag indicating whether each game starts from a random initial board.
+        bool random_initial_boards_;
+
+        // Writer of the shard the finished games are appended to, if any, and the mutex protecting it.
+        std::unique_ptr<ShardWriter> shard_writer_;
+        std::mutex shard_mutex_;
+
+        // Number of games each worker thread keeps running at the same time.
+        int nb_games_per_thread_;
+
+        // Number of games already started by the worker threads.
+        std::atomic<int> nb_started_games_;
+
+        // Total number of recorded training positions.
+        std::atomic<long> nb_positions_;
+
+        // Flag asking the worker threads to stop.
+        std::atomic<bool> stop_;
+
+        // Time at which the engine started.
+        std::chrono::steady_clock::time_point start_time_;
+
+        // Training samples of the finished games, not yet returned by 'next_sample'.
+        std::deque<TrainingSample> finished_samples_;
+
+        // Number of finished games, and number of worker threads still running.
+        int nb_finished_games_;
+        int nb_running_threads_;
+
+        // Number of finished games exempted from resignation that would have been resigned, and number of them
+        // that would have been wrongly resigned.
+        int nb_resignation_checks_;
+        int nb_false_resignations_;
+
+        // Protects the finished samples and the counters above.
+        mutable std::mutex samples_mutex_;
+
+        // Signaled when a game is finished or a worker thread exits.
+        std::condition_variable samples_condition_;
+
+        // The worker threads.
+        std::vector<std::thread> workers_;
+    };
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <utility>
+#include <torch/torch.h>
+#include <torch/script.h>
+#include "iris_zero/native_network.hpp"
+
+// The 'iris_zero' namespace is used to organize all IrisZero related components.
+namespace iris_zero
+{
+
+    // The Model class is a loaded IrisZero network, run either by TorchScript or by the native CPU engine
+    // (see 'include/iris_zero/native_network.hpp'). Copies of a Model share the same network.
+    class Model
+    {
+    public:
+        // Constructor taking a loaded TorchScript module.
+        explicit Model(torch::jit::script::Module module);
+
+        // Constructor taking a network of the native engine.
+        explicit Model(std::shared_ptr<const NativeNetwork> network);
+
+        // Evaluates a (batch size, NUMBER_REAL_NODES, NUMBER_ATRIBUTES) tensor of positions.
+        // Returns the policy logits (batch size, MAX_MVTS) and the values (batch size, 1). The softmax is left to the
+        // search, which normalizes the policy over the legal moves only.
+        std::pair<torch::Tensor, torch::Tensor> evaluate(const torch::Tensor &states_tensor);
+
+        // Returns true if the network is run by the native engine.
+        bool is_native() const;
+
+    private:
+        // The TorchScript module, if the network is not run by the native engine.
+        torch::jit::script::Module module_;
+
+        // The network of the native engine, if any.
+        std::shared_ptr<const NativeNetwork> network_;
+    };
+
+    // Quantizes the native model stored at 'model_path' to int8 (see 'NativeNetwork::quantize'), calibrated on a
+    // (nb positions, NUMBER_REAL_NODES, NUMBER_ATRIBUTES) tensor of positions, such as the positions of stored
+    // training samples, and saves it at 'quantized_model_path'.
+    // The quantized model is used by passing its path in place of the full precision one.
+    // Returns the policy KL divergence and the value MSE of the quantized model against the full precision one.
+    std::pair<float, float> quantize_model(const std::string &model_path, const std::string &quantized_model_path, const torch::Tensor &positions);
+}
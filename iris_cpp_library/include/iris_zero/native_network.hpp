@@ -0,0 +1,125 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// The 'iris_zero' namespace is used to organize all IrisZero related components.
+namespace iris_zero
+{
+
+    // Returns true if the file at 'model_path' holds weights exported for the native inference engine
+    // (see 'iris_python_code/model_utils/export/native_export.py'), rather than a TorchScript module.
+    bool is_native_model_file(const std::string &model_path);
+
+    // Accuracy of a quantized network compared to its full precision version, on a set of positions.
+    struct QuantizationReport
+    {
+        // Mean Kullback-Leibler divergence from the full precision policy to the quantized one.
+        float policy_kl;
+
+        // Mean squared error of the quantized values.
+        float value_mse;
+
+        // Number of positions of the comparison.
+        int nb_positions;
+    };
+
+    // The NativeNetwork class runs the IrisZero network (see 'iris_python_code/model_utils/model/IrisZeroNN.py')
+    // on the CPU without libtorch. The BatchNorm layers are folded into the preceding linear layers when the
+    // weights are loaded, the normalized adjacency matrix is stored as a sparse matrix, and every layer is a
+    // single pass over preallocated buffers, using AVX2/FMA kernels when the library is compiled for them.
+    class NativeNetwork
+    {
+    public:
+        // Constructor loading the weights exported at 'model_path', or a network saved by 'save'.
+        // Throws a std::runtime_error if the file cannot be read or is not a valid weight file.
+        explicit NativeNetwork(const std::string &model_path);
+
+        // Quantizes the network to int8, and returns the accuracy of the quantized network compared to the full
+        // precision one on the given positions (see 'encode_game_state').
+        // The weights are quantized with a scale per output channel, and the inputs of each layer (which are
+        // non-negative) to 7 bits with a scale per layer: the products are computed in int32 by the kernels.
+        // The positions are used for calibration: the input ranges of the layers are measured on them, and the
+        // clipping ranges of the weights and inputs of each layer are chosen, layer after layer, to minimize the
+        // policy divergence and value error on these positions.
+        QuantizationReport quantize(const float *states, int nb_states);
+
+        // Saves the network, with its BatchNorm folded and its weights quantized if 'quantize' was called.
+        // The saved file is loaded by the constructor (and by 'load_model') like an exported one.
+        void save(const std::string &model_path) const;
+
+        // Returns true if the weights are quantized.
+        bool is_quantized() const;
+
+        // Runs the network on 'batch_size' encoded positions (see 'encode_game_state'), and writes the policy
+        // logits (batch_size * action_size floats) and the values (batch_size floats).
+        // The buffers used by the computation are allocated once per thread, and reused by the following calls.
+        void forward(const float *states, int batch_size, float *policy_logits, float *values) const;
+
+        // Number of moves of the policy head.
+        int action_size() const;
+
+    private:
+        // A linear layer, whose weights are stored transposed (input_size rows of output_size values),
+        // so that the kernels read contiguous output channels. The weights are either in fp32, or quantized
+        // to int8 with a scale per output channel, and packed by groups of four inputs.
+        struct DenseLayer
+        {
+            int input_size;
+            int output_size;
+            std::vector<float> weights;
+            std::vector<std::int8_t> quantized_weights;
+            std::vector<float> scales;
+            float input_scale;
+            std::vector<float> bias;
+        };
+
+        // Quantizes the fp32 weights of a layer, the scale of each output channel covering 'weight_clip_ratio' times
+        // its largest weight, and the inputs of the layer over [0, input_range]. The fp32 weights are kept.
+        static void quantize_layer(DenseLayer &layer, float weight_clip_ratio, float input_range);
+
+        // Runs the network, and records the largest input of each layer (in the order of 'layers') if
+        // 'input_ranges' is not null.
+        void forward(const float *states, int batch_size, float *policy_logits, float *values, float *input_ranges) const;
+
+        // Returns the layers of the network, in the order of the forward pass.
+        std::vector<DenseLayer *> layers();
+        std::vector<const DenseLayer *> layers() const;
+
+        // Computes 'rows' rows of a linear layer, then applies a ReLU if 'relu' is set.
+        // Records the largest input in 'input_range' if it is not null.
+        static void dense(const float *input, int rows, const DenseLayer &layer, bool bias, bool relu, float *output, float *input_range);
+
+        // Graph convolution of the nodes of 'batch_size' positions: the linear layer without its bias, then the
+        // aggregation over the neighbours with the normalized adjacency matrix, the bias, an optional residual
+        // connection and a ReLU.
+        void graph_convolution(const float *input, int batch_size, const DenseLayer &layer, const float *residual, float *buffer, float *output, float *input_range) const;
+
+        // Number of nodes of the board graph, input channels per node, channels of the residual tower,
+        // and channels of the value head convolution.
+        int nb_nodes_;
+        int input_channels_;
+        int nb_channels_;
+        int value_head_channels_;
+
+        // Normalized adjacency matrix, in compressed sparse row format.
+        std::vector<int> adjacency_offsets_;
+        std::vector<int> adjacency_columns_;
+        std::vector<float> adjacency_values_;
+
+        // Graph convolutions of the initial block and of the residual blocks (two per block), with the
+        // BatchNorm folded in.
+        DenseLayer initial_convolution_;
+        std::vector<DenseLayer> residual_convolutions_;
+
+        // Policy head: graph convolution to two channels, and linear layer to the moves. The rows of the linear
+        // layer are reordered to read the node-major output of the convolution.
+        DenseLayer policy_convolution_;
+        DenseLayer policy_dense_;
+
+        // Value head: graph convolution, and two linear layers (rows reordered as for the policy head).
+        DenseLayer value_convolution_;
+        DenseLayer value_dense_1_;
+        DenseLayer value_dense_2_;
+    };
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <string>
+
+// The 'iris_zero' namespace is used to organize all IrisZero related components.
+namespace iris_zero
+{
+
+    // Refreshes the training targets of the positions of a self-play shard (see 'include/iris_zero/sample_shard.hpp')
+    // with a given model: each position is searched again with 'nb_simulations' simulations, without noise, and its
+    // record is rewritten in place with the policy of the search, and a value target mixing the stored one with the
+    // value of the search ('value_weight' is the weight of the search value, between 0 and 1).
+    // The records from 'first_record' are reanalysed, 'nb_records' of them (all the following ones if negative).
+    // Positions already won are left unchanged.
+    // The searches run on 'nb_threads' worker threads, and their leaves are evaluated with batched forward passes of
+    // 'batch_size' positions. The shard is memory-mapped, so a replay buffer mapping the same shard samples the
+    // refreshed targets as soon as they are written.
+    // Returns the number of reanalysed positions.
+    // Throws a std::runtime_error if the shard cannot be mapped or is not a shard.
+    long reanalyse_shard(
+        const std::string &shard_path,
+        const std::string &model_path,
+        int nb_simulations,
+        float value_weight,
+        int nb_threads,
+        int batch_size,
+        long first_record = 0,
+        long nb_records = -1);
+}
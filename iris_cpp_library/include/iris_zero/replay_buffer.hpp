@@ -0,0 +1,104 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <torch/torch.h>
+#include "iris_zero/iris_zero_training.hpp"
+
+// The 'iris_zero' namespace is used to organize all IrisZero related components.
+namespace iris_zero
+{
+
+    // The ReplayBuffer class samples training minibatches from self-play shards (see
+    // 'include/iris_zero/sample_shard.hpp'). The shards are memory-mapped, so only the sampled records are read from
+    // the disk, and the buffer only keeps the address of each record in memory.
+    // Each sampled position can be transformed by a random symmetry of the rules (see 'include/game/symmetry.hpp'),
+    // applied to the decoded game state and policy before the network input is encoded.
+    // A background thread expands the next minibatch into preallocated tensors while the current one is used for
+    // training. The tensors are returned without any copy, and are therefore reused: a minibatch is only valid until
+    // the next call to 'sample'.
+    class ReplayBuffer
+    {
+    public:
+        // Constructor taking the shards to sample from, the minibatch size, the recency exponent, whether the positions
+        // are transformed by a random symmetry, and the seed of the random generator. The probability of sampling a
+        // position grows as its rank from the oldest position to the power of the recency exponent: 0 samples
+        // uniformly, larger values favor the most recent positions.
+        // The positions are ordered as their shards, then as their records in a shard.
+        // Throws a std::runtime_error if a shard cannot be mapped or is not a shard.
+        ReplayBuffer(const std::vector<std::string> &shard_paths, int batch_size, float recency_exponent, bool augment, unsigned int seed);
+
+        // Stops the background thread and unmaps the shards.
+        ~ReplayBuffer();
+
+        ReplayBuffer(const ReplayBuffer &) = delete;
+        ReplayBuffer &operator=(const ReplayBuffer &) = delete;
+
+        // Maps a new shard, whose positions are more recent than the ones already in the buffer.
+        // The records written to the shard after this call are not sampled.
+        // Throws a std::runtime_error if the shard cannot be mapped or is not a shard.
+        void add_shard(const std::string &shard_path);
+
+        // Number of positions in the buffer.
+        long size() const;
+
+        // Blocks until the next minibatch is ready and returns it: the stacked network inputs, policies and values.
+        // Throws a std::runtime_error if the buffer is empty.
+        TrainingSample sample();
+
+    private:
+        // A memory-mapped shard.
+        struct MappedShard
+        {
+            const std::uint8_t *data;
+            std::size_t size;
+        };
+
+        // Maps a shard and appends its records to the index. The index mutex must be held.
+        void map_shard(const std::string &shard_path);
+
+        // Expands randomly drawn positions into a minibatch.
+        void fill_batch(TrainingSample &batch);
+
+        // Function run by the background thread.
+        void prefetch_loop();
+
+        // Minibatch size, recency exponent, and flag indicating whether the positions are transformed.
+        int batch_size_;
+        float recency_exponent_;
+        bool augment_;
+
+        // The mapped shards, and the address of every record.
+        std::vector<MappedShard> shards_;
+        std::vector<const std::uint8_t *> records_;
+
+        // Protects the shards and the records.
+        mutable std::mutex index_mutex_;
+
+        // Random generator used by the background thread.
+        std::mt19937 gen_;
+
+        // The two minibatches: one being filled by the background thread, the other one returned by 'sample'.
+        TrainingSample batches_[2];
+
+        // Index of the minibatch ready to be returned (-1 if none), index of the last returned minibatch, and flag
+        // asking the background thread to stop.
+        int ready_batch_;
+        int returned_batch_;
+        bool stop_;
+
+        // Protects the three fields above.
+        std::mutex batch_mutex_;
+
+        // Signaled when a minibatch is ready, or when the background thread can fill the next one.
+        std::condition_variable batch_condition_;
+
+        // The background thread.
+        std::thread prefetch_thread_;
+    };
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "game/game_constants.hpp"
+#include "game/state.hpp"
+#include "game/packed_state.hpp"
+#include "iris_zero/iris_zero_training.hpp"
+
+// The 'iris_zero' namespace is used to organize all IrisZero related components.
+namespace iris_zero
+{
+
+    // A shard is an append-only file of self-play training positions: a header ("IRSS" and the format version on 4
+    // bytes), followed by variable-length records. A record stores:
+    // - the packed game state (PACKED_STATE_SIZE bytes, see 'include/game/packed_state.hpp'),
+    // - the value target for yellow, scaled by 127 (1 signed byte): the outcome of the game, or the value of a search
+    //   refreshing the targets (see 'include/iris_zero/reanalyse.hpp'),
+    // - the number of legal moves of the position (1 byte),
+    // - the search policy over the legal moves only, in the order of 'game::legal_moves_mask', each probability
+    //   quantized to a byte relative to the largest one.
+    // A position takes about 30 bytes, instead of about 2 KB for its network input and dense policy.
+
+    // Size in bytes of the header of a shard.
+    const int SHARD_HEADER_SIZE = 8;
+
+    // Maximum size in bytes of a record (a position has at most MAX_MVTS legal moves).
+    const int MAX_SAMPLE_RECORD_SIZE = game::PACKED_STATE_SIZE + 2 + game::MAX_MVTS;
+
+    // Writes the record of a position, given its search policy (MAX_MVTS probabilities) and its value target for yellow
+    // (between -1 and 1), in 'record' (at least MAX_SAMPLE_RECORD_SIZE bytes). Returns the size of the record.
+    int encode_sample_record(const game::GameState &state, const float *policy, float value, std::uint8_t *record);
+
+    // Returns the size in bytes of the record starting at 'record'.
+    int sample_record_size(const std::uint8_t *record);
+
+    // Decodes a record to the state of its position, its dense policy (MAX_MVTS probabilities) and its value.
+    void decode_sample_record(const std::uint8_t *record, game::GameState *state, float *policy, float *value);
+
+    // Expands a record to the network input of its position (see 'encode_game_state'), its dense policy (MAX_MVTS
+    // probabilities) and its value. The state of the position is also written in 'state' if it is not null.
+    void expand_sample_record(const std::uint8_t *record, float *planes, float *policy, float *value, game::GameState *state = nullptr);
+
+    // Checks the header of a shard of 'size' bytes, and returns the offsets of its records.
+    // Throws a std::runtime_error if the data is not a valid shard.
+    std::vector<std::int64_t> index_shard(const std::uint8_t *data, std::size_t size, const std::string &shard_path);
+
+    // The ShardWriter class appends positions to a shard, creating it if it does not exist.
+    // The records are buffered, and written when the buffer is full, when 'flush' is called, and on destruction.
+    class ShardWriter
+    {
+    public:
+        // Constructor opening the shard at 'shard_path'.
+        // Throws a std::runtime_error if the file cannot be opened, or is not a shard.
+        explicit ShardWriter(const std::string &shard_path);
+
+        // Writes the buffered records.
+        ~ShardWriter();
+
+        // Appends a position, given its search policy (MAX_MVTS probabilities) and the outcome of its game for yellow.
+        void write(const game::GameState &state, const float *policy, float outcome);
+
+        // Writes the buffered records to the file.
+        void flush();
+
+        // Number of positions appended by this writer.
+        long nb_records() const;
+
+    private:
+        std::string shard_path_;
+        std::ofstream file_;
+        std::vector<std::uint8_t> buffer_;
+        long nb_records_;
+    };
+
+    // Loads every position of the shard at 'shard_path', expanded to tensors: the stacked network inputs, policies
+    // and values, as returned by 'generate_training_sample'.
+    // Throws a std::runtime_error if the file cannot be read or is not a shard.
+    TrainingSample load_shard(const std::string &shard_path);
+}
@@ -0,0 +1,185 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+#include "game/state.hpp"
+#include "iris_zero/inference_server.hpp"
+#include "iris_zero/iris_zero_search.hpp"
+
+// The 'iris_zero' namespace is used to organize all IrisZero related components.
+namespace iris_zero
+{
+
+    // A search advanced one simulation at a time by a SimulationScheduler. A simulation is started by
+    // 'next_leaf', which selects a leaf and marks it with 'begin_evaluation'. The simulation is then suspended
+    // until the evaluation of its leaf is available, and resumed by 'complete'.
+    // Several simulations of the same search can be suspended at the same time.
+    class SearchTask
+    {
+    public:
+        virtual ~SearchTask() = default;
+
+        // Starts a new simulation and returns the leaf it waits for, or returns nullptr if the search cannot start
+        // a simulation now (it is finished, or it has to wait for its suspended simulations).
+        virtual Node *next_leaf() = 0;
+
+        // Resumes the simulation waiting for this leaf, with the evaluation of the leaf.
+        virtual void complete(Node *leaf, const Evaluation &evaluation) = 0;
+
+        // Returns true if the search is over and has no suspended simulation.
+        virtual bool is_finished() const = 0;
+    };
+
+    // The SimulationScheduler class keeps many simulations in flight on a single thread: it starts simulations
+    // of its searches while their leaves are evaluated by the inference server, and resumes them as their
+    // evaluations become available. This gives leaf parallelism without one thread per simulation.
+    class SimulationScheduler
+    {
+    public:
+        // Constructor taking the inference server, and the maximum number of suspended simulations.
+        SimulationScheduler(InferenceServer &server, int max_in_flight);
+
+        // Adds a search to be advanced by the scheduler. The search is not owned by the scheduler.
+        void add(SearchTask *task);
+
+        // Advances the searches until one of them is finished, removes it from the scheduler and returns it.
+        // Returns nullptr if there is no search left.
+        SearchTask *run_until_finished();
+
+    private:
+        // A suspended simulation, waiting for the evaluation of its leaf.
+        struct Simulation
+        {
+            SearchTask *task;
+            Node *leaf;
+            std::future<Evaluation> evaluation;
+        };
+
+        // Resumes the oldest suspended simulation (blocking until its evaluation is available), then every
+        // other one whose evaluation is already available.
+        void resume_simulations();
+
+        // Server evaluating the leaves.
+        InferenceServer &server_;
+
+        // Maximum number of suspended simulations.
+        int max_in_flight_;
+
+        // Searches advanced by the scheduler.
+        std::vector<SearchTask *> tasks_;
+
+        // Index of the search starting the next simulation, to share the simulations between the searches.
+        int next_task_;
+
+        // Suspended simulations, in the order they were started.
+        std::deque<Simulation> in_flight_;
+    };
+
+    // The SimulationSearch class is a search task running a fixed number of simulations from a root,
+    // possibly under a time limit.
+    class SimulationSearch : public SearchTask
+    {
+    public:
+        // Constructor taking the root of the search, the number of simulations, the time limit in seconds
+        // (a negative 'reflexion_time' means no time limit), and the maximum number of suspended simulations.
+        SimulationSearch(Node *root_node, int nb_simulations, float reflexion_time, int max_in_flight);
+
+        Node *next_leaf() override;
+        void complete(Node *leaf, const Evaluation &evaluation) override;
+        bool is_finished() const override;
+
+    private:
+        // Returns true if the time limit is reached.
+        bool time_is_over() const;
+
+        Node *root_node_;
+        int nb_simulations_;
+        float reflexion_time_;
+        int max_in_flight_;
+
+        // Number of simulations started, and number of them currently suspended.
+        int nb_launched_simulations_;
+        int nb_pending_simulations_;
+
+        // Time at which the search started.
+        std::chrono::steady_clock::time_point start_time_;
+    };
+
+    // Runs 'nb_simulations' simulations from the root, stopping earlier if 'reflexion_time' seconds have elapsed
+    // (a negative 'reflexion_time' means no time limit). The leaves are evaluated by the inference server, and up to
+    // 'max_in_flight' simulations are suspended on their evaluation while the search keeps selecting other leaves.
+    void run_simulations(Node *root_node, InferenceServer &server, int nb_simulations, float reflexion_time, int max_in_flight);
+
+    // The RootSearch class is a search task owning the root of a position and the search running from it
+    // ('SimulationSearch' or 'GumbelSearch'), for the many positions searched by 'run_searches'.
+    class RootSearch : public SearchTask
+    {
+    public:
+        // Constructor taking the searched position. The search has to be set before the task is run.
+        explicit RootSearch(const game::GameState &state);
+
+        Node *next_leaf() override;
+        void complete(Node *leaf, const Evaluation &evaluation) override;
+        bool is_finished() const override;
+
+        // Value of the root according to the search, from 1 (yellow wins) to -1 (red wins), as 'game::winner'.
+        float value() const;
+
+        // Root of the search, and the search running from it.
+        std::unique_ptr<Node> root_node;
+        std::unique_ptr<SearchTask> search;
+    };
+
+    // Runs many searches on a single thread, with a SimulationScheduler keeping 'nb_searches' of them running at the
+    // same time, each with up to 'max_in_flight' suspended simulations, so that their leaves fill the batches of the
+    // inference server. 'start_search' returns the next search to run, or nullptr once there is none left, and
+    // 'finish_search' is called with each finished search before it is destroyed.
+    // Returns once all the searches are finished, or once 'stop' is set. The suspended simulations are completed
+    // before the searches still running are destroyed.
+    template <typename Search>
+    void run_searches(
+        InferenceServer &server,
+        int nb_searches,
+        int max_in_flight,
+        const std::function<std::unique_ptr<Search>()> &start_search,
+        const std::function<void(Search &)> &finish_search,
+        const std::atomic<bool> *stop = nullptr)
+    {
+        SimulationScheduler scheduler(server, max_in_flight * nb_searches);
+        std::vector<std::unique_ptr<Search>> searches;
+
+        while (stop == nullptr || !stop->load())
+        {
+            while (static_cast<int>(searches.size()) < nb_searches)
+            {
+                std::unique_ptr<Search> search = start_search();
+                if (!search)
+                {
+                    break;
+                }
+                scheduler.add(search.get());
+                searches.push_back(std::move(search));
+            }
+
+            SearchTask *finished_search = scheduler.run_until_finished();
+            if (finished_search == nullptr || (stop != nullptr && stop->load()))
+            {
+                break;
+            }
+
+            auto it = std::find_if(searches.begin(), searches.end(), [finished_search](const std::unique_ptr<Search> &search)
+                                   { return search.get() == finished_search; });
+            finish_search(**it);
+            searches.erase(it);
+        }
+
+        while (scheduler.run_until_finished() != nullptr)
+        {
+        }
+    }
+}
@@ -1,5 +1,8 @@
 #pragma once
+#include <atomic>
+#include <functional>
 #include <utility>
+#include "game/state.hpp"
 
 // The 'mcts' namespace is used to organize all mcts related components.
 namespace mcts
@@ -47,4 +50,21 @@ namespace mcts
         int white_consecutive_last_use,
         int orange_consecutive_last_use,
         int nb_simulations);
+
+    // Returns the best move according to a mcts search from a given game state and a given thinking time in seconds,
+    // see 'mcts_bot_time'.
+    std::pair<int, int> mcts_bot_time_int(float reflexion_time, const game::GameState &root_state);
+
+    // Returns the best move according to a mcts search from a given game state and a given number of simulations,
+    // see 'mcts_bot_sim'.
+    std::pair<int, int> mcts_bot_sim_int(int nb_simulations, const game::GameState &root_state);
+
+    // Callback receiving the current best move of a search, in the Python format (see 'move_to_python_format').
+    using ProgressCallback = std::function<void(std::pair<int, int>)>;
+
+    // Returns the best move according to a mcts search from a given game state. The search runs 'nb_simulations'
+    // simulations, and stops earlier once 'reflexion_time' seconds have elapsed (a negative 'reflexion_time' means no
+    // time limit) or once 'stop' is set, after at least one simulation.
+    // If 'progress' is set, it receives the current best move every PROGRESS_INTERVAL simulations.
+    std::pair<int, int> mcts_search_int(const game::GameState &root_state, int nb_simulations, float reflexion_time, const std::atomic<bool> &stop, const ProgressCallback &progress);
 }
\ No newline at end of file
@@ -9,4 +9,7 @@ namespace mcts
     
     // Max number of turn per game simulation.
     extern const int MAX_TURN_PER_GAME_SIM;
+
+    // Number of simulations between two reports of the current best move of a search.
+    extern const int PROGRESS_INTERVAL;
 }
\ No newline at end of file
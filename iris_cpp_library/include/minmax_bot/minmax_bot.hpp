@@ -1,5 +1,6 @@
 #pragma once
 #include <utility>
+#include "game/state.hpp"
 
 // The 'minmax_bot' namespace is used to organize all minmax related components.
 namespace minmax_bot
@@ -26,4 +27,7 @@ namespace minmax_bot
         int white_consecutive_last_use,
         int orange_consecutive_last_use,
         int depth);
+
+    // Returns the best move according to a minmax search from a given game state and a given depth, see 'minmax_bot'.
+    std::pair<int, int> minmax_bot_int(int depth, const game::GameState &state);
 }
\ No newline at end of file
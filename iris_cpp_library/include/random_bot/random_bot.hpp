@@ -1,5 +1,6 @@
 #pragma once
 #include <utility>
+#include "game/state.hpp"
 
 // The 'random_bot' namespace is used to organize all random bot related components.
 namespace random_bot
@@ -25,4 +26,7 @@ namespace random_bot
         int black_consecutive_last_use,
         int white_consecutive_last_use,
         int orange_consecutive_last_use);
+
+    // Returns a random valid move from a given game state, see 'random_bot'.
+    std::pair<int, int> random_bot_int(const game::GameState &state);
 }
\ No newline at end of file
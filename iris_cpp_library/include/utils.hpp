@@ -1,94 +1,150 @@
 #pragma once
 
-#include <utility>
+#include <cstring>
+#include <vector>
 #include <torch/torch.h>
 #include "game/game_constants.hpp"
-#include "game/move_iterator.hpp"
+#include "game/state.hpp"
 #include "iris_zero/iris_zero_constants.hpp"
 
-// Converts and summarizes a move from the game's internal representation to a format easily
-// interoperable with Python. It takes as input the initial game state before the move and
-// the resulting game state after the move. It returns a pair of integers representing the move. 
-// The first element is the index of the moved pawn 
-// (0 : current player's pawn, 1 : black pawn, 2 : white pawn, 3 : orange pawn, -1 : no legal move)
-// and the second is the chosen node's index in the game board.
-inline std::pair<int, int> move_to_python_format(const game::GameState &parent, const game::GameState &child)
+// Index of the first column of the state representation broadcast over all the nodes (pawn usage and player's turn).
+const int FIRST_BROADCAST_COLUMN = 10;
+
+// Computes the masks of the nodes holding each of the five tile types (yr, yb, yw, rb, rw).
+// A node holds at most one tile, the masks follow the priority of the tile types. Node 0 never holds a tile.
+inline void tile_masks(const game::GameState &state, int masks[5])
+{
+    int board = ((1 << game::NUMBER_REAL_NODES) - 1) & ~1;
+    masks[0] = state.yellow_colors & state.red_colors & board;
+    masks[1] = state.yellow_colors & state.black_colors & board & ~masks[0];
+    masks[2] = state.yellow_colors & state.white_colors & board & ~(masks[0] | masks[1]);
+    masks[3] = state.red_colors & state.black_colors & board & ~(masks[0] | masks[1] | masks[2]);
+    masks[4] = state.red_colors & state.white_colors & board & ~(masks[0] | masks[1] | masks[2] | masks[3]);
+}
+
+// Writes the broadcast columns of the state representation (pawn usage and player's turn) in a single row.
+inline void encode_broadcast_columns(const game::GameState &state, float *row)
 {
+    const int nb_columns = iris_zero::NUMBER_ATRIBUTES;
 
-    // Recovering the index of the move.
-    int index;
-    for (const std::pair<int, game::GameState> &move : game::MoveGenerator(parent)) 
+    std::memset(row + FIRST_BROADCAST_COLUMN, 0, sizeof(float) * (nb_columns - FIRST_BROADCAST_COLUMN));
+
+    // Pawn usage, with the four columns of each neutral pawn.
+    auto set_usage = [row](int column, bool last_use, int consecutive_last_use)
     {
-        if (move.second == child)
+        if (consecutive_last_use == 1 || consecutive_last_use == 2)
         {
-            index = move.first;
-            break;
+            row[column + ((last_use) ? 0 : 2) + consecutive_last_use - 1] = 1.0;
         }
-    }
+    };
+    set_usage(FIRST_BROADCAST_COLUMN, state.black_last_use, state.black_consecutive_last_use);
+    set_usage(FIRST_BROADCAST_COLUMN + 4, state.white_last_use, state.white_consecutive_last_use);
+    set_usage(FIRST_BROADCAST_COLUMN + 8, state.orange_last_use, state.orange_consecutive_last_use);
 
-    // Index between 0 and game::MAX_MVT_PER_PAWN means that the player pawn is being played.
-    if (index < game::MAX_MVT_PER_PAWN)
-    {
-        int real_index = index;
-
-        // Moved pawn is player pawn.
-        int moved_pawn = 0;
-
-        // Recover the node the pawn is moved to with the index.
-        int chosen_node = (parent.yellow_is_playing) ? game::NODE_NEIGHBOURS[parent.yellow_position][real_index] : game::NODE_NEIGHBOURS[parent.red_position][real_index];
-
-        return std::make_pair(moved_pawn, chosen_node);
-    }
-    // Index between game::MAX_MVT_PER_PAWN and 2 * game::MAX_MVT_PER_PAWN means that the black pawn is being played.
-    else if (index < 2 * game::MAX_MVT_PER_PAWN)
-    {
+    // Player's turn.
+    row[nb_columns - 1] = (state.yellow_is_playing) ? 0.0 : 1.0;
+}
 
-        // Get the index of the moved node.
-        int real_index = index - game::MAX_MVT_PER_PAWN; 
+// Writes the representation described for 'game_state_to_tensor' into a caller-owned buffer of
+// NUMBER_REAL_NODES * NUMBER_ATRIBUTES floats (row-major, one row per node), so that positions can be
+// encoded straight into a reusable batch buffer.
+// The columns broadcast over all the nodes are written once in the first row and copied to the other rows,
+// and the one-hot tile columns are set by iterating over the bits of the tile masks.
+inline void encode_game_state(const game::GameState &state, float *planes)
+{
+    const int nb_columns = iris_zero::NUMBER_ATRIBUTES;
 
-        // Black pawn is moved.
-        int moved_pawn = 1;
+    std::memset(planes, 0, sizeof(float) * game::NUMBER_REAL_NODES * nb_columns);
 
-        // Recover the node the pawn is moved to with the index.
-        int chosen_node = game::NODE_NEIGHBOURS[parent.black_position][real_index];
+    // Pawns' locations.
+    planes[state.yellow_position * nb_columns + 0] = 1.0;
+    planes[state.red_position * nb_columns + 1] = 1.0;
+    planes[state.black_position * nb_columns + 2] = 1.0;
+    planes[state.white_position * nb_columns + 3] = 1.0;
+    planes[state.orange_position * nb_columns + 4] = 1.0;
 
-        return std::make_pair(moved_pawn, chosen_node);
-    }
-    // Index between 2 * game::MAX_MVT_PER_PAWN and 3 * game::MAX_MVT_PER_PAWN means that the white pawn is being played.
-    else if (index < 3 * game::MAX_MVT_PER_PAWN)
+    // Tiles' locations.
+    int masks[5];
+    tile_masks(state, masks);
+    for (int type = 0; type < 5; type++)
     {
-
-        // Get the index of the moved node.
-        int real_index = index - 2 * game::MAX_MVT_PER_PAWN;
-
-        // White pawn is moved.
-        int moved_pawn = 2;
-
-        // Recover the node the pawn is moved to with the index.
-        int chosen_node = game::NODE_NEIGHBOURS[parent.white_position][real_index];
-
-        return std::make_pair(moved_pawn, chosen_node);
+        for (int tiles = masks[type]; tiles != 0; tiles &= tiles - 1)
+        {
+            planes[__builtin_ctz(tiles) * nb_columns + 5 + type] = 1.0;
+        }
     }
-    // Index between 3 * game::MAX_MVT_PER_PAWN and 4 * game::MAX_MVT_PER_PAWN means that the orange pawn is being played.
-    else if (index < 4 * game::MAX_MVT_PER_PAWN)
-    {
 
-        // Get the index of the moved node.
-        int real_index = index - 3 * game::MAX_MVT_PER_PAWN;
+    // Copy the broadcast columns of the first row to the other rows.
+    encode_broadcast_columns(state, planes);
+    for (int k = 1; k < game::NUMBER_REAL_NODES; k++)
+    {
+        std::memcpy(planes + k * nb_columns + FIRST_BROADCAST_COLUMN,
+                    planes + FIRST_BROADCAST_COLUMN,
+                    sizeof(float) * (nb_columns - FIRST_BROADCAST_COLUMN));
+    }
+}
 
-        // Orange pawn is moved.
-        int moved_pawn = 3;
+// Writes the representation of the child state into 'planes', from the representation of its parent state.
+// A move only changes a few cells: the moved pawn's column, the tiles of the changed nodes, and some broadcast
+// columns (at least the player's turn). Only these cells are rewritten after copying the parent's representation.
+// 'planes' and 'parent_planes' must not overlap.
+inline void encode_game_state_delta(const game::GameState &parent, const float *parent_planes, const game::GameState &child, float *planes)
+{
+    const int nb_columns = iris_zero::NUMBER_ATRIBUTES;
 
-        // Recover the node the pawn is moved to with the index.
-        int chosen_node = game::NODE_NEIGHBOURS[parent.orange_position][real_index];
+    std::memcpy(planes, parent_planes, sizeof(float) * game::NUMBER_REAL_NODES * nb_columns);
 
-        return std::make_pair(moved_pawn, chosen_node);
+    // Pawns' locations.
+    auto move_pawn = [planes, nb_columns](int parent_position, int child_position, int column)
+    {
+        if (parent_position != child_position)
+        {
+            planes[parent_position * nb_columns + column] = 0.0;
+            planes[child_position * nb_columns + column] = 1.0;
+        }
+    };
+    move_pawn(parent.yellow_position, child.yellow_position, 0);
+    move_pawn(parent.red_position, child.red_position, 1);
+    move_pawn(parent.black_position, child.black_position, 2);
+    move_pawn(parent.white_position, child.white_position, 3);
+    move_pawn(parent.orange_position, child.orange_position, 4);
+
+    // Tiles' locations, only on the nodes whose tile changed.
+    int parent_masks[5];
+    int child_masks[5];
+    tile_masks(parent, parent_masks);
+    tile_masks(child, child_masks);
+    for (int type = 0; type < 5; type++)
+    {
+        for (int tiles = parent_masks[type] ^ child_masks[type]; tiles != 0; tiles &= tiles - 1)
+        {
+            int node = __builtin_ctz(tiles);
+            planes[node * nb_columns + 5 + type] = (child_masks[type] >> node) & 1;
+        }
     }
-    else
+
+    // Broadcast columns: the first row is rewritten, and only the changed columns are copied to the other rows.
+    encode_broadcast_columns(child, planes);
+    for (int column = FIRST_BROADCAST_COLUMN; column < nb_columns; column++)
     {
+        if (planes[column] != parent_planes[column])
+        {
+            for (int k = 1; k < game::NUMBER_REAL_NODES; k++)
+            {
+                planes[k * nb_columns + column] = planes[column];
+            }
+        }
+    }
+}
 
-        // index = 4 * game::MAX_MVT_PER_PAWN : no legal move
-        return std::make_pair(-1, -1);
+// Encodes several game states into consecutive rows of a caller-owned buffer of
+// nb_states * NUMBER_REAL_NODES * NUMBER_ATRIBUTES floats, see 'encode_game_state'.
+inline void encode_game_states(const game::GameState *states, int nb_states, float *planes)
+{
+    const int state_size = game::NUMBER_REAL_NODES * iris_zero::NUMBER_ATRIBUTES;
+    for (int k = 0; k < nb_states; k++)
+    {
+        encode_game_state(states[k], planes + k * state_size);
     }
 }
 
@@ -112,132 +168,15 @@ inline std::pair<int, int> move_to_python_format(const game::GameState &parent,
 //
 inline torch::Tensor game_state_to_tensor(const game::GameState &state)
 {
-    torch::Tensor state_tensor = torch::zeros({game::NUMBER_REAL_NODES, iris_zero::NUMBER_ATRIBUTES});
-    auto state_tensor_accessor = state_tensor.accessor<float, 2>();
-
-    state_tensor_accessor[state.yellow_position][0] = 1.0;
-    state_tensor_accessor[state.red_position][1] = 1.0;
-    state_tensor_accessor[state.black_position][2] = 1.0;
-    state_tensor_accessor[state.white_position][3] = 1.0;
-    state_tensor_accessor[state.orange_position][4] = 1.0;
-
-    for (int k = 1; k < game::NUMBER_REAL_NODES; k++)
-    {
-        int pos = 1 << k;
-        bool yr = state.yellow_colors & state.red_colors & pos;
-        bool yb = state.yellow_colors & state.black_colors & pos;
-        bool yw = state.yellow_colors & state.white_colors & pos;
-        bool rb = state.red_colors & state.black_colors & pos;
-        bool rw = state.red_colors & state.white_colors & pos;
-
-        if (yr)
-        {
-            state_tensor_accessor[k][5] = 1.0;
-        }
-        else if (yb)
-        {
-            state_tensor_accessor[k][6] = 1.0;
-        }
-        else if (yw)
-        {
-            state_tensor_accessor[k][7] = 1.0;
-        }
-        else if (rb)
-        {
-            state_tensor_accessor[k][8] = 1.0;
-        }
-        else if (rw)
-        {
-            state_tensor_accessor[k][9] = 1.0;
-        }
-    }
-
-    if (state.black_last_use)
-    {
-        if (state.black_consecutive_last_use == 1)
-        {
-            for (int k = 0; k < game::NUMBER_REAL_NODES; k++)
-                state_tensor_accessor[k][10] = 1.0;
-        }
-        if (state.black_consecutive_last_use == 2)
-        {
-            for (int k = 0; k < game::NUMBER_REAL_NODES; k++)
-                state_tensor_accessor[k][11] = 1.0;
-        }
-    }
-    else
-    {
-        if (state.black_consecutive_last_use == 1)
-        {
-            for (int k = 0; k < game::NUMBER_REAL_NODES; k++)
-                state_tensor_accessor[k][12] = 1.0;
-        }
-        if (state.black_consecutive_last_use == 2)
-        {
-            for (int k = 0; k < game::NUMBER_REAL_NODES; k++)
-                state_tensor_accessor[k][13] = 1.0;
-        }
-    }
-
-    if (state.white_last_use)
-    {
-        if (state.white_consecutive_last_use == 1)
-        {
-            for (int k = 0; k < game::NUMBER_REAL_NODES; k++)
-                state_tensor_accessor[k][14] = 1.0;
-        }
-        if (state.white_consecutive_last_use == 2)
-        {
-            for (int k = 0; k < game::NUMBER_REAL_NODES; k++)
-                state_tensor_accessor[k][15] = 1.0;
-        }
-    }
-    else
-    {
-        if (state.white_consecutive_last_use == 1)
-        {
-            for (int k = 0; k < game::NUMBER_REAL_NODES; k++)
-                state_tensor_accessor[k][16] = 1.0;
-        }
-        if (state.white_consecutive_last_use == 2)
-        {
-            for (int k = 0; k < game::NUMBER_REAL_NODES; k++)
-                state_tensor_accessor[k][17] = 1.0;
-        }
-    }
-
-    if (state.orange_last_use)
-    {
-        if (state.orange_consecutive_last_use == 1)
-        {
-            for (int k = 0; k < game::NUMBER_REAL_NODES; k++)
-                state_tensor_accessor[k][18] = 1.0;
-        }
-        if (state.orange_consecutive_last_use == 2)
-        {
-            for (int k = 0; k < game::NUMBER_REAL_NODES; k++)
-                state_tensor_accessor[k][19] = 1.0;
-        }
-    }
-    else
-    {
-        if (state.orange_consecutive_last_use == 1)
-        {
-            for (int k = 0; k < game::NUMBER_REAL_NODES; k++)
-                state_tensor_accessor[k][20] = 1.0;
-        }
-        if (state.orange_consecutive_last_use == 2)
-        {
-            for (int k = 0; k < game::NUMBER_REAL_NODES; k++)
-                state_tensor_accessor[k][21] = 1.0;
-        }
-    }
-
-    if (!state.yellow_is_playing)
-    {
-        for (int k = 0; k < game::NUMBER_REAL_NODES; k++)
-            state_tensor_accessor[k][22] = 1.0;
-    }
-
+    torch::Tensor state_tensor = torch::empty({game::NUMBER_REAL_NODES, iris_zero::NUMBER_ATRIBUTES});
+    encode_game_state(state, state_tensor.data_ptr<float>());
     return state_tensor;
-}
\ No newline at end of file
+}
+
+// Transforms several game states into a (nb_states, NUMBER_REAL_NODES, NUMBER_ATRIBUTES) tensor, see 'game_state_to_tensor'.
+inline torch::Tensor game_states_to_tensor(const std::vector<game::GameState> &states)
+{
+    torch::Tensor states_tensor = torch::empty({static_cast<long>(states.size()), game::NUMBER_REAL_NODES, iris_zero::NUMBER_ATRIBUTES});
+    encode_game_states(states.data(), states.size(), states_tensor.data_ptr<float>());
+    return states_tensor;
+}
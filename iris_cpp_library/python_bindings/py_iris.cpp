@@ -1,5 +1,6 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <pybind11/numpy.h>
 #include <torch/torch.h>
 #include <torch/extension.h>
 #include "random_bot/random_bot.hpp"
@@ -7,6 +8,18 @@
 #include "mcts/mcts_bot.hpp"
 #include "iris_zero/iris_zero_bot.hpp"
 #include "iris_zero/iris_zero_training.hpp"
+#include "iris_zero/model.hpp"
+#include "iris_zero/sample_shard.hpp"
+#include "iris_zero/replay_buffer.hpp"
+#include "iris_zero/reanalyse.hpp"
+#include "iris_zero/analysis.hpp"
+#include "arena/arena.hpp"
+#include "async_search/search_handle.hpp"
+#include "game/initial_board.hpp"
+#include "game/packed_state.hpp"
+#include "game/rules.hpp"
+#include "game/state.hpp"
+#include "utils.hpp"
 
 // Namespace for pybind11
 namespace py = pybind11;
@@ -18,25 +31,405 @@ PYBIND11_MODULE(py_iris, m)
 
     // Documentation for the entire Python module
     m.doc() = "py_iris module: C++ implementations of various game-playing algorithms, and training routines for AlphaZero, exposed to Python through PyBind11.";
-    
+
+    // Exposing the 'GameState' structure to Python, so that a position is converted once instead of field by field on
+    // every call. The fields are in the order of 'to_tuple', as the arguments of the functions taking a position.
+    py::class_<game::GameState>(m, "GameState", "A complete state of the game, see include/game/state.hpp")
+        .def(py::init([](bool yellow_is_playing,
+                         int yellow_position,
+                         int red_position,
+                         int black_position,
+                         int white_position,
+                         int orange_position,
+                         int yellow_colors,
+                         int red_colors,
+                         int black_colors,
+                         int white_colors,
+                         bool black_last_use,
+                         bool white_last_use,
+                         bool orange_last_use,
+                         int black_consecutive_last_use,
+                         int white_consecutive_last_use,
+                         int orange_consecutive_last_use)
+                      { return game::GameState{
+                            yellow_is_playing,
+                            yellow_position,
+                            red_position,
+                            black_position,
+                            white_position,
+                            orange_position,
+                            yellow_colors,
+                            red_colors,
+                            black_colors,
+                            white_colors,
+                            black_last_use,
+                            white_last_use,
+                            orange_last_use,
+                            black_consecutive_last_use,
+                            white_consecutive_last_use,
+                            orange_consecutive_last_use}; }),
+             "Builds a game state from its fields, in the order of 'to_tuple'")
+        .def_static("random", py::overload_cast<unsigned int>(&game::random_initial_state), "Returns an initial game state with a random tile layout, given by a seed")
+        .def_static("from_layout", &game::layout_initial_state, "Returns the initial game state of a layout index")
+        .def_readwrite("yellow_is_playing", &game::GameState::yellow_is_playing)
+        .def_readwrite("yellow_position", &game::GameState::yellow_position)
+        .def_readwrite("red_position", &game::GameState::red_position)
+        .def_readwrite("black_position", &game::GameState::black_position)
+        .def_readwrite("white_position", &game::GameState::white_position)
+        .def_readwrite("orange_position", &game::GameState::orange_position)
+        .def_readwrite("yellow_colors", &game::GameState::yellow_colors)
+        .def_readwrite("red_colors", &game::GameState::red_colors)
+        .def_readwrite("black_colors", &game::GameState::black_colors)
+        .def_readwrite("white_colors", &game::GameState::white_colors)
+        .def_readwrite("black_last_use", &game::GameState::black_last_use)
+        .def_readwrite("white_last_use", &game::GameState::white_last_use)
+        .def_readwrite("orange_last_use", &game::GameState::orange_last_use)
+        .def_readwrite("black_consecutive_last_use", &game::GameState::black_consecutive_last_use)
+        .def_readwrite("white_consecutive_last_use", &game::GameState::white_consecutive_last_use)
+        .def_readwrite("orange_consecutive_last_use", &game::GameState::orange_consecutive_last_use)
+        .def("legal_moves", [](const game::GameState &state)
+             {
+                 std::vector<int> moves;
+                 for (std::uint64_t mask = game::legal_moves_mask(state); mask != 0; mask &= mask - 1)
+                 {
+                     moves.push_back(__builtin_ctzll(mask));
+                 }
+                 return moves; },
+             "Returns the indexes of the legal moves: k * 10 + i moves the k-th pawn (player's pawn, black, white, orange) to its i-th neighbour, and 40 is the no-move rule")
+        .def("apply", [](const game::GameState &state, int move)
+             {
+                 if (move < 0 || move >= game::MAX_MVTS || !((game::legal_moves_mask(state) >> move) & 1))
+                 {
+                     throw std::runtime_error("Illegal move: " + std::to_string(move));
+                 }
+                 return game::apply_move(state, move); },
+             "Returns the game state after a legal move, given by its index (see 'legal_moves')")
+        .def("winner", &game::winner, "Returns 1 if yellow won, -1 if red won, and 0 if there is no winner yet")
+        .def("move_index", &game::move_from_python_format, py::arg("moved_pawn"), py::arg("chosen_node"),
+             "Returns the index of a move given in the Python format (pawn, node), 40 for pawn -1 (the no-move rule), and -1 if the node is not a neighbour of the pawn")
+        .def("is_valid_move", [](const game::GameState &state, int moved_pawn, int chosen_node)
+             {
+                 int move = game::move_from_python_format(state, moved_pawn, chosen_node);
+                 return move >= 0 && move < game::MAX_MVTS - 1 && ((game::legal_moves_mask(state) >> move) & 1); },
+             py::arg("moved_pawn"), py::arg("chosen_node"),
+             "Returns whether moving a pawn (player's pawn, black, white, orange) to a node is legal")
+        .def("exists_move", &game::exists_move,
+             "Returns whether the current player has a legal move, i.e. does not have to apply the no-move rule")
+        .def("legal_destinations", [](const game::GameState &state)
+             {
+                 std::array<int, 4> destinations;
+                 game::legal_destinations(state, destinations.data());
+                 return destinations; },
+             "Returns, for each pawn the current player can move (player's pawn, black, white, orange), the bitfield of the nodes it can legally be moved to")
+        .def("to_tuple", [](const game::GameState &state)
+             { return py::make_tuple(state.yellow_is_playing,
+                                     state.yellow_position,
+                                     state.red_position,
+                                     state.black_position,
+                                     state.white_position,
+                                     state.orange_position,
+                                     state.yellow_colors,
+                                     state.red_colors,
+                                     state.black_colors,
+                                     state.white_colors,
+                                     state.black_last_use,
+                                     state.white_last_use,
+                                     state.orange_last_use,
+                                     state.black_consecutive_last_use,
+                                     state.white_consecutive_last_use,
+                                     state.orange_consecutive_last_use); },
+             "Returns the fields of the game state as a tuple")
+        .def("__eq__", [](const game::GameState &lhs, const game::GameState &rhs)
+             { return lhs == rhs; })
+        .def("__hash__", [](const game::GameState &state)
+             { return game::packed_game_state_hash(game::pack_game_state(state)); });
+
+    // The game states can also be passed as NumPy structured arrays of this dtype, for the functions on batches of positions.
+    PYBIND11_NUMPY_DTYPE(game::GameState,
+                         yellow_is_playing,
+                         yellow_position,
+                         red_position,
+                         black_position,
+                         white_position,
+                         orange_position,
+                         yellow_colors,
+                         red_colors,
+                         black_colors,
+                         white_colors,
+                         black_last_use,
+                         white_last_use,
+                         orange_last_use,
+                         black_consecutive_last_use,
+                         white_consecutive_last_use,
+                         orange_consecutive_last_use);
+    m.attr("game_state_dtype") = py::dtype::of<game::GameState>();
+
+    // Exposing the functions on batches of game states to Python.
+    m.def("legal_moves_masks", [](py::array_t<game::GameState, py::array::c_style | py::array::forcecast> states)
+          {
+              py::array_t<std::uint64_t> masks(states.size());
+              const game::GameState *state_data = states.data();
+              std::uint64_t *mask_data = masks.mutable_data();
+              for (py::ssize_t k = 0; k < states.size(); k++)
+              {
+                  mask_data[k] = game::legal_moves_mask(state_data[k]);
+              }
+              return masks; },
+          "A function returning the legal moves of an array of game states, as bitmasks of the move indexes (see 'GameState.legal_moves')");
+    m.def("encode_game_states", [](py::array_t<game::GameState, py::array::c_style | py::array::forcecast> states)
+          {
+              torch::Tensor states_tensor = torch::empty({static_cast<long>(states.size()), game::NUMBER_REAL_NODES, iris_zero::NUMBER_ATRIBUTES});
+              encode_game_states(states.data(), states.size(), states_tensor.data_ptr<float>());
+              return states_tensor; },
+          "A function returning the stacked representations of an array of game states, as given to the model");
+
+    // Exposing the bots to Python. Each bot takes either the fields of a position, or a 'GameState'.
+    // The GIL is released by every long-running call, so that other Python threads keep running during the searches.
+
     // Exposing the 'random_bot' function to Python.
-    m.def("random_bot", &random_bot::random_bot, "A function returning a random valid move from a given position");
+    m.def("random_bot", &random_bot::random_bot, "A function returning a random valid move from a given position",
+          py::call_guard<py::gil_scoped_release>());
+    m.def("random_bot", &random_bot::random_bot_int, "A function returning a random valid move from a given GameState",
+          py::call_guard<py::gil_scoped_release>());
 
     // Exposing the 'minmax_bot' function to Python.
-    m.def("minmax_bot", &minmax_bot::minmax_bot, "A function returning the best move according to a minmax search from a given position and a given depth");
+    m.def("minmax_bot", &minmax_bot::minmax_bot, "A function returning the best move according to a minmax search from a given position and a given depth",
+          py::call_guard<py::gil_scoped_release>());
+    m.def("minmax_bot", [](const game::GameState &state, int depth)
+          { return minmax_bot::minmax_bot_int(depth, state); },
+          "A function returning the best move according to a minmax search from a given GameState and a given depth",
+          py::call_guard<py::gil_scoped_release>());
 
     // Exposing the 'mcts_bot_time' function to Python.
-    m.def("mcts_bot_time", &mcts::mcts_bot_time, "A function returning the best move according to a mcts search from a given position and a given thinking time in seconds");
+    m.def("mcts_bot_time", &mcts::mcts_bot_time, "A function returning the best move according to a mcts search from a given position and a given thinking time in seconds",
+          py::call_guard<py::gil_scoped_release>());
+    m.def("mcts_bot_time", [](const game::GameState &state, float reflexion_time)
+          { return mcts::mcts_bot_time_int(reflexion_time, state); },
+          "A function returning the best move according to a mcts search from a given GameState and a given thinking time in seconds",
+          py::call_guard<py::gil_scoped_release>());
 
     // Exposing the 'mcts_bot_sim' function to Python.
-    m.def("mcts_bot_sim", &mcts::mcts_bot_sim, "A function returning the best move according to a mcts search from a given position and a given number of simulations");
+    m.def("mcts_bot_sim", &mcts::mcts_bot_sim, "A function returning the best move according to a mcts search from a given position and a given number of simulations",
+          py::call_guard<py::gil_scoped_release>());
+    m.def("mcts_bot_sim", [](const game::GameState &state, int nb_simulations)
+          { return mcts::mcts_bot_sim_int(nb_simulations, state); },
+          "A function returning the best move according to a mcts search from a given GameState and a given number of simulations",
+          py::call_guard<py::gil_scoped_release>());
 
     // Exposing the 'iris_zero_bot_time' function to Python.
-    m.def("iris_zero_bot_time", &iris_zero::iris_zero_bot_time, "A function returning the best move according to a model search from a given position and a given thinking time in seconds");
+    m.def("iris_zero_bot_time", &iris_zero::iris_zero_bot_time, "A function returning the best move according to a model search from a given position and a given thinking time in seconds",
+          py::call_guard<py::gil_scoped_release>());
+    m.def("iris_zero_bot_time", &iris_zero::iris_zero_bot_time_int, "A function returning the best move according to a model search from a given GameState and a given thinking time in seconds",
+          py::call_guard<py::gil_scoped_release>());
 
     // Exposing the 'iris_zero_bot_sim' function to Python.
-    m.def("iris_zero_bot_sim", &iris_zero::iris_zero_bot_sim, "A function returning the best move according to a model search from a given position and a given number of simulations");
+    m.def("iris_zero_bot_sim", &iris_zero::iris_zero_bot_sim, "A function returning the best move according to a model search from a given position and a given number of simulations",
+          py::call_guard<py::gil_scoped_release>());
+    m.def("iris_zero_bot_sim", &iris_zero::iris_zero_bot_sim_int, "A function returning the best move according to a model search from a given GameState and a given number of simulations",
+          py::call_guard<py::gil_scoped_release>());
+
+    // Exposing the 'iris_zero_bot_gumbel' function to Python.
+    m.def("iris_zero_bot_gumbel", &iris_zero::iris_zero_bot_gumbel, "A function returning the best move according to a model search with a Gumbel root from a given position and a given number of simulations, for small simulation budgets",
+          py::call_guard<py::gil_scoped_release>());
+    m.def("iris_zero_bot_gumbel", &iris_zero::iris_zero_bot_gumbel_int, "A function returning the best move according to a model search with a Gumbel root from a given GameState and a given number of simulations, for small simulation budgets",
+          py::call_guard<py::gil_scoped_release>());
 
     // Exposing the 'generate_training_sample' function to Python.
-    m.def("generate_training_sample", &iris_zero::generate_training_sample, "A function returning a self played game from a position and a given model, to be used for training");
+    m.def("generate_training_sample", &iris_zero::generate_training_sample, "A function returning a self played game from a position and a given model, to be used for training",
+          py::call_guard<py::gil_scoped_release>());
+    m.def("generate_training_sample", &iris_zero::generate_training_sample_int, "A function returning a self played game from a GameState and a given model, to be used for training",
+          py::call_guard<py::gil_scoped_release>());
+
+    // Exposing the 'quantize_model' function to Python.
+    m.def("quantize_model", &iris_zero::quantize_model, "A function quantizing a native model to int8, calibrated on a tensor of positions. Returns the policy KL divergence and value MSE against the full precision model",
+          py::call_guard<py::gil_scoped_release>());
+
+    // Exposing the 'load_shard' function to Python.
+    m.def("load_shard", &iris_zero::load_shard, "A function loading every position of a self-play shard, as the stacked game state representations, policies and values",
+          py::call_guard<py::gil_scoped_release>());
+
+    // Exposing the initial board generation to Python. The boards are returned as the tile bitfields of
+    // 'generate_random_board' (yellow, red, black and white colors).
+    m.def("random_board", [](unsigned int seed)
+          {
+              game::GameState state = game::random_initial_state(seed);
+              return std::make_tuple(state.yellow_colors, state.red_colors, state.black_colors, state.white_colors); },
+          "A function returning the tile bitfields of a random initial board, given by a seed");
+    m.def("layout_board", [](int layout)
+          {
+              game::GameState state = game::layout_initial_state(layout);
+              return std::make_tuple(state.yellow_colors, state.red_colors, state.black_colors, state.white_colors); },
+          "A function returning the tile bitfields of the initial board of a layout index");
+    m.def("distinct_layouts", []()
+          {
+              std::vector<int> layouts = game::distinct_layouts();
+              return torch::tensor(torch::ArrayRef<int>(layouts), torch::kInt32); },
+          "A function returning the layout indexes of the distinct initial boards modulo the symmetries of the rules, as an int32 tensor",
+          py::call_guard<py::gil_scoped_release>());
+
+    // Exposing the 'reanalyse_shard' function to Python. The GIL is released, so that it can run alongside the training.
+    m.def("reanalyse_shard", &iris_zero::reanalyse_shard, "A function refreshing the policy and value targets of the positions of a self-play shard with a new search by a given model. Returns the number of reanalysed positions",
+          py::arg("shard_path"), py::arg("model_path"), py::arg("nb_simulations"), py::arg("value_weight"), py::arg("nb_threads"), py::arg("batch_size"), py::arg("first_record") = 0, py::arg("nb_records") = -1,
+          py::call_guard<py::gil_scoped_release>());
+
+    // Exposing the batch analysis to Python. The positions are given as a list of 'GameState', or as an array of
+    // dtype 'game_state_dtype'.
+    py::class_<iris_zero::PositionAnalysis>(m, "PositionAnalysis", "Result of the search of a position by 'analyse_positions'")
+        .def_readonly("best_move", &iris_zero::PositionAnalysis::best_move)
+        .def_readonly("value", &iris_zero::PositionAnalysis::value)
+        .def_readonly("visits", &iris_zero::PositionAnalysis::visits)
+        .def_readonly("principal_variation", &iris_zero::PositionAnalysis::principal_variation);
+    m.def("analyse_positions", &iris_zero::analyse_positions, "A function searching many positions with a model loaded once, on several threads sharing batched evaluations. Returns, per position, the best move, the value (1 if yellow wins), the visit distribution and the principal variation",
+          py::arg("states"), py::arg("model_path"), py::arg("nb_simulations"), py::arg("use_gumbel") = false, py::arg("nb_threads") = 4, py::arg("batch_size") = 64,
+          py::call_guard<py::gil_scoped_release>());
+    m.def("analyse_positions", [](py::array_t<game::GameState, py::array::c_style | py::array::forcecast> states, const std::string &model_path, int nb_simulations, bool use_gumbel, int nb_threads, int batch_size)
+          {
+              std::vector<game::GameState> state_vector(states.data(), states.data() + states.size());
+              py::gil_scoped_release release;
+              return iris_zero::analyse_positions(state_vector, model_path, nb_simulations, use_gumbel, nb_threads, batch_size); },
+          "A function searching an array of game states, see the version taking a list of 'GameState'",
+          py::arg("states"), py::arg("model_path"), py::arg("nb_simulations"), py::arg("use_gumbel") = false, py::arg("nb_threads") = 4, py::arg("batch_size") = 64);
+
+    // Exposing the 'ReplayBuffer' class to Python.
+    py::class_<iris_zero::ReplayBuffer>(m, "ReplayBuffer", "A replay buffer sampling training minibatches from memory-mapped self-play shards")
+        .def(py::init<const std::vector<std::string> &, int, float, bool, unsigned int>(), py::call_guard<py::gil_scoped_release>(),
+             "Maps the given shards, to sample minibatches of 'batch_size' positions, favoring the recent positions if 'recency_exponent' is positive, and transforming each position by a random symmetry if 'augment' is set")
+        .def("add_shard", &iris_zero::ReplayBuffer::add_shard, "Maps a new shard, whose positions are more recent than the ones already in the buffer", py::call_guard<py::gil_scoped_release>())
+        .def("size", &iris_zero::ReplayBuffer::size, "Number of positions in the buffer")
+        .def("sample", &iris_zero::ReplayBuffer::sample, "Returns the next minibatch: the stacked game state representations, policies and values. The tensors are reused by the next call", py::call_guard<py::gil_scoped_release>())
+        .def("__len__", &iris_zero::ReplayBuffer::size);
+
+    // Exposing the 'SelfPlayEngine' class to Python, as an iterator over the training samples of the finished games.
+    py::class_<iris_zero::SelfPlayEngine>(m, "SelfPlayEngine", "A self-play engine playing several games concurrently, with batched model evaluations")
+        .def(py::init([](const game::GameState &state,
+                         int nb_games,
+                         const std::string &model_path,
+                         int nb_threads,
+                         int batch_size,
+                         bool use_gumbel_search,
+                         const std::string &shard_path,
+                         bool random_initial_boards)
+                      { return std::make_unique<iris_zero::SelfPlayEngine>(state, nb_games, model_path, nb_threads, batch_size, use_gumbel_search, shard_path, random_initial_boards); }),
+             "Starts playing self-play games from a given 'GameState', see the constructor taking the fields of the position", py::call_guard<py::gil_scoped_release>(),
+             py::arg("state"), py::arg("nb_games"), py::arg("model_path"), py::arg("nb_threads"), py::arg("batch_size"),
+             py::arg("use_gumbel_search") = false, py::arg("shard_path") = "", py::arg("random_initial_boards") = false)
+        .def(py::init([](bool yellow_is_playing,
+                         int yellow_position,
+                         int red_position,
+                         int black_position,
+                         int white_position,
+                         int orange_position,
+                         int yellow_colors,
+                         int red_colors,
+                         int black_colors,
+                         int white_colors,
+                         bool black_last_use,
+                         bool white_last_use,
+                         bool orange_last_use,
+                         int black_consecutive_last_use,
+                         int white_consecutive_last_use,
+                         int orange_consecutive_last_use,
+                         int nb_games,
+                         const std::string &model_path,
+                         int nb_threads,
+                         int batch_size,
+                         bool use_gumbel_search,
+                         const std::string &shard_path,
+                         bool random_initial_boards)
+                      {
+                          game::GameState state = {
+                              yellow_is_playing,
+                              yellow_position,
+                              red_position,
+                              black_position,
+                              white_position,
+                              orange_position,
+                              yellow_colors,
+                              red_colors,
+                              black_colors,
+                              white_colors,
+                              black_last_use,
+                              white_last_use,
+                              orange_last_use,
+                              black_consecutive_last_use,
+                              white_consecutive_last_use,
+                              orange_consecutive_last_use};
+                          return std::make_unique<iris_zero::SelfPlayEngine>(state, nb_games, model_path, nb_threads, batch_size, use_gumbel_search, shard_path, random_initial_boards);
+                      }),
+             "Starts playing 'nb_games' self-play games from a given position, with 'nb_threads' worker threads and 'batch_size' positions per forward pass, searching the moves with the Gumbel root search if 'use_gumbel_search' is set, appending the finished games to the shard at 'shard_path' instead of returning them if it is not empty, and starting each game from a random initial board instead of the given position if 'random_initial_boards' is set", py::call_guard<py::gil_scoped_release>(),
+             py::arg("yellow_is_playing"), py::arg("yellow_position"), py::arg("red_position"), py::arg("black_position"), py::arg("white_position"), py::arg("orange_position"),
+             py::arg("yellow_colors"), py::arg("red_colors"), py::arg("black_colors"), py::arg("white_colors"),
+             py::arg("black_last_use"), py::arg("white_last_use"), py::arg("orange_last_use"),
+             py::arg("black_consecutive_last_use"), py::arg("white_consecutive_last_use"), py::arg("orange_consecutive_last_use"),
+             py::arg("nb_games"), py::arg("model_path"), py::arg("nb_threads"), py::arg("batch_size"),
+             py::arg("use_gumbel_search") = false, py::arg("shard_path") = "", py::arg("random_initial_boards") = false)
+        .def("next_sample", &iris_zero::SelfPlayEngine::next_sample, "Blocks until a game is finished and returns its training sample, or None when all the games have been returned", py::call_guard<py::gil_scoped_release>())
+        .def("positions_per_second", &iris_zero::SelfPlayEngine::positions_per_second, "Number of recorded training positions per second since the engine started")
+        .def("average_batch_size", &iris_zero::SelfPlayEngine::average_batch_size, "Average number of positions per forward pass since the engine started")
+        .def("cache_hit_rate", &iris_zero::SelfPlayEngine::cache_hit_rate, "Fraction of the leaf evaluations found in the evaluation cache since the engine started")
+        .def("nb_finished_games", &iris_zero::SelfPlayEngine::nb_finished_games, "Number of finished games")
+        .def("false_resignation_rate", &iris_zero::SelfPlayEngine::false_resignation_rate, "Fraction of the games exempted from resignation that would have been wrongly resigned")
+        .def("__iter__", [](iris_zero::SelfPlayEngine &engine) -> iris_zero::SelfPlayEngine & { return engine; }, py::return_value_policy::reference_internal)
+        .def("__next__", [](iris_zero::SelfPlayEngine &engine)
+             {
+                 std::optional<iris_zero::TrainingSample> sample;
+                 {
+                     py::gil_scoped_release release;
+                     sample = engine.next_sample();
+                 }
+                 if (!sample)
+                 {
+                     throw py::stop_iteration();
+                 }
+                 return *sample; });
+
+    // Exposing the arena to Python, to evaluate two engines against each other.
+    py::enum_<arena::EngineType>(m, "EngineType", "The playing algorithms of an arena engine")
+        .value("RANDOM", arena::EngineType::RANDOM)
+        .value("MINMAX", arena::EngineType::MINMAX)
+        .value("MCTS", arena::EngineType::MCTS)
+        .value("IRIS_ZERO", arena::EngineType::IRIS_ZERO)
+        .value("IRIS_ZERO_GUMBEL", arena::EngineType::IRIS_ZERO_GUMBEL);
+
+    py::class_<arena::EngineConfig>(m, "EngineConfig", "Configuration of an arena engine: its algorithm, the depth of the minmax search, the number of simulations per move of the MCTS and IrisZero searches, and the model of the IrisZero searches")
+        .def(py::init<>())
+        .def_readwrite("type", &arena::EngineConfig::type)
+        .def_readwrite("depth", &arena::EngineConfig::depth)
+        .def_readwrite("nb_simulations", &arena::EngineConfig::nb_simulations)
+        .def_readwrite("model_path", &arena::EngineConfig::model_path);
+
+    py::class_<arena::SprtConfig>(m, "SprtConfig", "Configuration of the SPRT stopping an arena early, deciding between the first engine being 'elo0' and 'elo1' stronger than the second one")
+        .def(py::init<>())
+        .def_readwrite("enabled", &arena::SprtConfig::enabled)
+        .def_readwrite("elo0", &arena::SprtConfig::elo0)
+        .def_readwrite("elo1", &arena::SprtConfig::elo1)
+        .def_readwrite("alpha", &arena::SprtConfig::alpha)
+        .def_readwrite("beta", &arena::SprtConfig::beta);
+
+    py::class_<arena::ArenaResult>(m, "ArenaResult", "Results of an arena, counted for the first engine")
+        .def_readonly("nb_games", &arena::ArenaResult::nb_games)
+        .def_readonly("wins", &arena::ArenaResult::wins)
+        .def_readonly("draws", &arena::ArenaResult::draws)
+        .def_readonly("losses", &arena::ArenaResult::losses)
+        .def_readonly("score", &arena::ArenaResult::score)
+        .def_readonly("elo", &arena::ArenaResult::elo)
+        .def_readonly("elo_error", &arena::ArenaResult::elo_error)
+        .def_readonly("llr", &arena::ArenaResult::llr)
+        .def_readonly("sprt_decision", &arena::ArenaResult::sprt_decision);
+
+    // Exposing the 'play_arena' function to Python. The GIL is released while the games are played.
+    m.def("play_arena", &arena::play_arena, "A function playing games between two engines on several threads, in pairs with swapped colors on random tile layouts, and returning the win rate and Elo difference of the first engine. The SPRT, if enabled, stops the arena early",
+          py::arg("first_engine"), py::arg("second_engine"), py::arg("nb_games"), py::arg("nb_threads"), py::arg("seed"), py::arg("sprt") = arena::SprtConfig(),
+          py::call_guard<py::gil_scoped_release>());
+
+    // Exposing the 'SearchHandle' class to Python, to search a move in the background.
+    py::class_<async_search::SearchHandle>(m, "SearchHandle", "A search of a move by an engine, running in the background. The MCTS and IrisZero searches report their current best move, and can be stopped early")
+        .def(py::init<const game::GameState &, const arena::EngineConfig &, float>(),
+             "Starts searching the move of an engine from a given GameState, for at most 'reflexion_time' seconds if it is not negative",
+             py::arg("state"), py::arg("engine"), py::arg("reflexion_time") = -1.0)
+        .def("poll", &async_search::SearchHandle::poll, "Returns True if the search is over")
+        .def("best_so_far", &async_search::SearchHandle::best_so_far, "Returns the current best move, or None if the search has not reported any move yet")
+        .def("stop", &async_search::SearchHandle::stop, "Asks the search to stop as soon as possible, with the best move found so far")
+        .def("result", &async_search::SearchHandle::result, "Blocks until the search is over and returns its move",
+             py::call_guard<py::gil_scoped_release>());
 }
\ No newline at end of file
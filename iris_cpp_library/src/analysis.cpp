@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <torch/torch.h>
+#include "game/game_constants.hpp"
+#include "game/move.hpp"
+#include "game/rules.hpp"
+#include "iris_zero/analysis.hpp"
+#include "iris_zero/gumbel_search.hpp"
+#include "iris_zero/inference_server.hpp"
+#include "iris_zero/iris_zero_constants.hpp"
+#include "iris_zero/iris_zero_search.hpp"
+#include "iris_zero/simulation_scheduler.hpp"
+
+// Implementation of the batch analysis of positions, see 'include/iris_zero/analysis.hpp'.
+namespace iris_zero
+{
+    // The search of a position, and the index of its analysis.
+    struct AnalysisTask : public RootSearch
+    {
+        AnalysisTask(const game::GameState &state, std::size_t index) : RootSearch(state),
+                                                                        index(index),
+                                                                        gen(0) {}
+
+        std::size_t index;
+
+        // The random generator of a Gumbel search, which keeps a reference to it.
+        std::mt19937 gen;
+    };
+
+    // Returns the analysis of a searched position.
+    PositionAnalysis read_analysis(const AnalysisTask &task, bool use_gumbel)
+    {
+        Node *root_node = task.root_node.get();
+        PositionAnalysis analysis;
+        analysis.value = task.value();
+
+        Node *best_child = (use_gumbel) ? static_cast<GumbelSearch *>(task.search.get())->selected_child()
+                                        : next_move_best(root_node).second;
+        analysis.best_move = game::move_to_python_format(root_node->state, best_child->move);
+
+        // A Gumbel search of a root with a single legal move ends after its evaluation, without visiting its child.
+        if (root_node->visits > 1)
+        {
+            torch::Tensor policy = node_mcts_policy(root_node);
+            analysis.visits.assign(policy.data_ptr<float>(), policy.data_ptr<float>() + game::MAX_MVTS);
+        }
+        else
+        {
+            analysis.visits.assign(game::MAX_MVTS, 0.0f);
+            analysis.visits[best_child->move.index] = 1.0f;
+        }
+
+        // The line follows the most visited moves until it reaches a node the search did not expand.
+        Node *node = root_node;
+        Node *child = best_child;
+        while (true)
+        {
+            analysis.principal_variation.push_back(game::move_to_python_format(node->state, child->move));
+            node = child;
+            if (node->children.empty())
+            {
+                break;
+            }
+            child = next_move_best(node).second;
+            if (child->visits == 0)
+            {
+                break;
+            }
+        }
+
+        return analysis;
+    }
+
+    std::vector<PositionAnalysis> analyse_positions(
+        const std::vector<game::GameState> &states,
+        const std::string &model_path,
+        int nb_simulations,
+        bool use_gumbel,
+        int nb_threads,
+        int batch_size)
+    {
+        InferenceServer server(load_model(model_path), batch_size, std::chrono::microseconds(INFERENCE_MAX_WAIT_MICROSECONDS), INFERENCE_CACHE_SIZE);
+
+        std::vector<PositionAnalysis> analyses(states.size());
+
+        // The distribution of the visits of a root is taken after its first one.
+        nb_simulations = std::max(2, nb_simulations);
+        nb_threads = std::max(1, nb_threads);
+        int nb_searches_per_thread = std::max(1, (batch_size + nb_threads - 1) / nb_threads);
+
+        std::atomic<std::size_t> next_position(0);
+
+        // The next position to search. The positions already won are analysed without a search.
+        auto start_search = [&]() -> std::unique_ptr<AnalysisTask>
+        {
+            for (std::size_t position_index = next_position.fetch_add(1); position_index < states.size(); position_index = next_position.fetch_add(1))
+            {
+                const game::GameState &state = states[position_index];
+                if (game::exists_winner(state))
+                {
+                    analyses[position_index].best_move = std::make_pair(-1, -1);
+                    analyses[position_index].value = game::winner(state);
+                    analyses[position_index].visits.assign(game::MAX_MVTS, 0.0f);
+                    continue;
+                }
+
+                // The searches are deterministic, see 'iris_zero_bot_gumbel'.
+                auto task = std::make_unique<AnalysisTask>(state, position_index);
+                if (use_gumbel)
+                {
+                    task->search = std::make_unique<GumbelSearch>(task->root_node.get(), nb_simulations, BATCH_SEARCH_EVALUATIONS_IN_FLIGHT, task->gen, false);
+                }
+                else
+                {
+                    task->search = std::make_unique<SimulationSearch>(task->root_node.get(), nb_simulations, -1.0, BATCH_SEARCH_EVALUATIONS_IN_FLIGHT);
+                }
+                return task;
+            }
+            return nullptr;
+        };
+
+        auto finish_search = [&](AnalysisTask &task)
+        {
+            analyses[task.index] = read_analysis(task, use_gumbel);
+        };
+
+        // Each worker thread keeps 'nb_searches_per_thread' positions searched at the same time.
+        auto worker_loop = [&]()
+        {
+            run_searches<AnalysisTask>(server, nb_searches_per_thread, BATCH_SEARCH_EVALUATIONS_IN_FLIGHT, start_search, finish_search);
+        };
+
+        std::vector<std::thread> workers;
+        for (int k = 0; k < nb_threads; k++)
+        {
+            workers.emplace_back(worker_loop);
+        }
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+
+        return analyses;
+    }
+}
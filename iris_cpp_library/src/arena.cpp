@@ -0,0 +1,223 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "arena/arena.hpp"
+#include "arena/arena_constants.hpp"
+#include "game/game_constants.hpp"
+#include "game/initial_board.hpp"
+#include "game/rules.hpp"
+#include "random_bot/random_bot.hpp"
+#include "minmax_bot/minmax_bot.hpp"
+#include "mcts/mcts_bot.hpp"
+#include "iris_zero/gumbel_search.hpp"
+#include "iris_zero/inference_server.hpp"
+#include "iris_zero/iris_zero_constants.hpp"
+#include "iris_zero/iris_zero_search.hpp"
+#include "iris_zero/simulation_scheduler.hpp"
+
+// Implementation of the arena, see 'include/arena/arena.hpp'.
+namespace arena
+{
+    // An engine of the arena: its configuration, and the inference server of its model for the IrisZero engines.
+    struct ArenaEngine
+    {
+        EngineConfig config;
+        std::unique_ptr<iris_zero::InferenceServer> server;
+    };
+
+    // Applies a move given in the Python format (see 'move_to_python_format') and returns the new game state.
+    game::GameState apply_python_move(const game::GameState &state, std::pair<int, int> move)
+    {
+        int index = game::move_from_python_format(state, move.first, move.second);
+        if (index < 0)
+        {
+            throw std::runtime_error("An arena engine played an illegal move");
+        }
+        return game::apply_move(state, index);
+    }
+
+    // Returns the game state after the move chosen by an engine.
+    game::GameState play_engine_move(ArenaEngine &engine, const game::GameState &state)
+    {
+        // The no-move rule is applied without asking the engine.
+        if (!game::exists_move(state))
+        {
+            return game::apply_move(state, game::MAX_MVTS - 1);
+        }
+
+        switch (engine.config.type)
+        {
+        case EngineType::RANDOM:
+            return apply_python_move(state, random_bot::random_bot_int(state));
+        case EngineType::MINMAX:
+            return apply_python_move(state, minmax_bot::minmax_bot_int(engine.config.depth, state));
+        case EngineType::MCTS:
+            return apply_python_move(state, mcts::mcts_bot_sim_int(engine.config.nb_simulations, state));
+        case EngineType::IRIS_ZERO:
+        {
+            auto root_node = std::make_unique<iris_zero::Node>(state);
+            iris_zero::run_simulations(root_node.get(), *engine.server, engine.config.nb_simulations, -1.0, iris_zero::MAX_EVALUATIONS_IN_FLIGHT);
+            return iris_zero::next_move_best(root_node.get()).second->state;
+        }
+        case EngineType::IRIS_ZERO_GUMBEL:
+        {
+            // The search is deterministic, see 'iris_zero_bot_gumbel'.
+            std::mt19937 gen(0);
+            auto root_node = std::make_unique<iris_zero::Node>(state);
+            return iris_zero::run_gumbel_search(root_node.get(), *engine.server, engine.config.nb_simulations, iris_zero::MAX_EVALUATIONS_IN_FLIGHT, gen, false)->state;
+        }
+        }
+        throw std::runtime_error("Unknown arena engine type");
+    }
+
+    // Plays a game from an initial position, and returns its outcome: 1 if yellow wins, -1 if red wins, 0 for a draw.
+    int play_game(ArenaEngine &yellow_engine, ArenaEngine &red_engine, const game::GameState &initial_state)
+    {
+        game::GameState state = initial_state;
+        for (int turn = 0; turn < ARENA_MAX_TURNS; turn++)
+        {
+            state = play_engine_move((state.yellow_is_playing) ? yellow_engine : red_engine, state);
+            if (game::exists_winner(state))
+            {
+                return game::winner(state);
+            }
+        }
+        return 0;
+    }
+
+    // Returns the Elo difference corresponding to an expected score, bounded away from 0 and 1 by half a game.
+    float score_to_elo(float score, int nb_games)
+    {
+        float bound = 0.5 / nb_games;
+        score = std::clamp(score, bound, 1.0f - bound);
+        return -400.0 * std::log10(1.0 / score - 1.0);
+    }
+
+    // Returns the expected score corresponding to an Elo difference.
+    float elo_to_score(float elo)
+    {
+        return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+    }
+
+    // Computes the score, the Elo difference with its error, and the log-likelihood ratio of the SPRT from the game counts.
+    // The game scores are treated as independent draws from a distribution of mean 'score', whose variance is estimated
+    // from the counts (at least 1 / (4 * nb_games)), and the log-likelihood ratio is its normal approximation
+    // (generalized SPRT).
+    void update_statistics(ArenaResult &result, const SprtConfig &sprt)
+    {
+        int n = result.nb_games;
+        result.score = (result.wins + 0.5 * result.draws) / n;
+
+        float score = result.score;
+        float variance = (result.wins * (1.0 - score) * (1.0 - score) +
+                          result.draws * (0.5 - score) * (0.5 - score) +
+                          result.losses * score * score) /
+                         n;
+
+        // Without a floor, a run of only wins or only losses has no variance and the SPRT would never stop. The floor
+        // shrinks with the number of games, as the bound of 'score_to_elo'.
+        variance = std::max(variance, 0.25f / n);
+
+        float deviation = 1.96 * std::sqrt(variance / n);
+        result.elo = score_to_elo(score, n);
+        result.elo_error = 0.5 * (score_to_elo(score + deviation, n) - score_to_elo(score - deviation, n));
+
+        float score0 = elo_to_score(sprt.elo0);
+        float score1 = elo_to_score(sprt.elo1);
+        result.llr = n * (score1 - score0) * (2.0 * score - score0 - score1) / (2.0 * variance);
+    }
+
+    ArenaResult play_arena(
+        const EngineConfig &first_engine,
+        const EngineConfig &second_engine,
+        int nb_games,
+        int nb_threads,
+        unsigned int seed,
+        const SprtConfig &sprt)
+    {
+        nb_threads = std::max(1, nb_threads);
+
+        // The model of an IrisZero engine is loaded once, and its server batches the leaves of all the games.
+        ArenaEngine engines[2] = {{first_engine, nullptr}, {second_engine, nullptr}};
+        for (ArenaEngine &engine : engines)
+        {
+            if (engine.config.type == EngineType::IRIS_ZERO || engine.config.type == EngineType::IRIS_ZERO_GUMBEL)
+            {
+                engine.server = std::make_unique<iris_zero::InferenceServer>(iris_zero::load_model(engine.config.model_path),
+                                                                             nb_threads * iris_zero::MAX_EVALUATIONS_IN_FLIGHT,
+                                                                             std::chrono::microseconds(iris_zero::INFERENCE_MAX_WAIT_MICROSECONDS),
+                                                                             iris_zero::INFERENCE_CACHE_SIZE);
+            }
+        }
+
+        float lower_bound = std::log(sprt.beta / (1.0 - sprt.alpha));
+        float upper_bound = std::log((1.0 - sprt.beta) / sprt.alpha);
+
+        ArenaResult result = {0, 0, 0, 0, 0.0, 0.0, 0.0, 0.0, 0};
+        std::mutex result_mutex;
+        std::atomic<int> next_game(0);
+        std::atomic<bool> stop(false);
+
+        // Games 2k and 2k + 1 are played on the same layout, the first engine playing yellow in the even games.
+        auto worker_loop = [&]()
+        {
+            while (!stop)
+            {
+                int game_index = next_game.fetch_add(1);
+                if (game_index >= nb_games)
+                {
+                    break;
+                }
+
+                std::seed_seq layout_seed{seed, static_cast<unsigned int>(game_index / 2)};
+                std::mt19937 gen(layout_seed);
+                game::GameState initial_state = game::random_initial_state(gen);
+
+                bool first_is_yellow = (game_index % 2 == 0);
+                int outcome = (first_is_yellow) ? play_game(engines[0], engines[1], initial_state)
+                                                : -play_game(engines[1], engines[0], initial_state);
+
+                std::lock_guard<std::mutex> lock(result_mutex);
+                result.nb_games++;
+                result.wins += (outcome > 0);
+                result.draws += (outcome == 0);
+                result.losses += (outcome < 0);
+                update_statistics(result, sprt);
+                if (sprt.enabled && result.sprt_decision == 0)
+                {
+                    if (result.llr >= upper_bound)
+                    {
+                        result.sprt_decision = 1;
+                        stop = true;
+                    }
+                    else if (result.llr <= lower_bound)
+                    {
+                        result.sprt_decision = -1;
+                        stop = true;
+                    }
+                }
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (int k = 0; k < nb_threads; k++)
+        {
+            workers.emplace_back(worker_loop);
+        }
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+
+        return result;
+    }
+}
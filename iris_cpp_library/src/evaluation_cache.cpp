@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <mutex>
+#include <vector>
+#include <torch/torch.h>
+#include "game/game_constants.hpp"
+#include "game/packed_state.hpp"
+#include "game/symmetry.hpp"
+#include "iris_zero/evaluation_cache.hpp"
+
+// Implementation of the 'EvaluationCache' class, see 'include/iris_zero/evaluation_cache.hpp'.
+namespace iris_zero
+{
+    // Number of mutexes protecting the slots of the cache.
+    const int EVALUATION_CACHE_NB_MUTEXES = 64;
+
+    EvaluationCache::EvaluationCache(int nb_entries) : entries_(std::max(1, nb_entries)),
+                                                       mutexes_(EVALUATION_CACHE_NB_MUTEXES),
+                                                       nb_lookups_(0),
+                                                       nb_hits_(0)
+    {
+        for (Entry &entry : entries_)
+        {
+            entry.is_valid = false;
+        }
+    }
+
+    bool EvaluationCache::find(const game::CanonicalGameState &canonical, Evaluation &evaluation)
+    {
+        nb_lookups_++;
+
+        int index = slot(canonical);
+        torch::Tensor policy = torch::zeros({game::MAX_MVTS});
+        float *logits = policy.data_ptr<float>();
+        {
+            std::lock_guard<std::mutex> lock(mutexes_[index % EVALUATION_CACHE_NB_MUTEXES]);
+            const Entry &entry = entries_[index];
+            if (!entry.is_valid || !(entry.key == canonical.packed))
+            {
+                return false;
+            }
+
+            for (int move = 0; move < game::MAX_MVTS; move++)
+            {
+                if (canonical.original_moves[move] >= 0)
+                {
+                    logits[canonical.original_moves[move]] = entry.logits[move];
+                }
+            }
+            evaluation = Evaluation(policy, entry.value);
+        }
+
+        nb_hits_++;
+        return true;
+    }
+
+    void EvaluationCache::insert(const game::CanonicalGameState &canonical, const Evaluation &evaluation)
+    {
+        torch::Tensor policy = evaluation.first.contiguous();
+        const float *logits = policy.data_ptr<float>();
+
+        int index = slot(canonical);
+        std::lock_guard<std::mutex> lock(mutexes_[index % EVALUATION_CACHE_NB_MUTEXES]);
+        Entry &entry = entries_[index];
+        entry.key = canonical.packed;
+        entry.is_valid = true;
+        for (int move = 0; move < game::MAX_MVTS; move++)
+        {
+            entry.logits[move] = (canonical.original_moves[move] >= 0) ? logits[canonical.original_moves[move]] : 0.0f;
+        }
+        entry.value = evaluation.second;
+    }
+
+    float EvaluationCache::hit_rate() const
+    {
+        long nb_lookups = nb_lookups_.load();
+        return (nb_lookups > 0) ? static_cast<float>(nb_hits_.load()) / nb_lookups : 0.0;
+    }
+
+    int EvaluationCache::slot(const game::CanonicalGameState &canonical) const
+    {
+        return game::packed_game_state_hash(canonical.packed) % entries_.size();
+    }
+}
@@ -0,0 +1,344 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+#include <torch/torch.h>
+#include "game/game_constants.hpp"
+#include "iris_zero/gumbel_search.hpp"
+#include "iris_zero/iris_zero_search.hpp"
+#include "iris_zero/iris_zero_constants.hpp"
+#include "iris_zero/simulation_scheduler.hpp"
+
+// Implementation of the 'GumbelSearch' class, see 'include/iris_zero/gumbel_search.hpp'.
+namespace iris_zero
+{
+    GumbelSearch::GumbelSearch(
+        Node *root_node,
+        int nb_simulations,
+        int max_in_flight,
+        std::mt19937 &gen,
+        bool add_noise) : root_node_(root_node),
+                          nb_simulations_(std::max(1, nb_simulations)),
+                          max_in_flight_(std::max(1, max_in_flight)),
+                          gen_(gen),
+                          add_noise_(add_noise),
+                          nb_launched_simulations_(0),
+                          nb_pending_simulations_(0),
+                          is_started_(false),
+                          halving_is_over_(false),
+                          gumbel_(),
+                          log_priors_(),
+                          considered_(),
+                          target_visits_(),
+                          nb_phases_(0),
+                          phase_(0),
+                          next_considered_(0)
+    {
+        // A root reused from a previous search is already expanded.
+        if (root_node_->is_expanded)
+        {
+            start_search();
+        }
+    }
+
+    Node *GumbelSearch::next_leaf()
+    {
+        while (nb_launched_simulations_ < nb_simulations_ && nb_pending_simulations_ < max_in_flight_ && !halving_is_over_)
+        {
+            // The root is evaluated first, its policy gives the considered moves.
+            if (!root_node_->is_expanded)
+            {
+                if (root_node_->evaluation_pending)
+                {
+                    return nullptr;
+                }
+                begin_evaluation(root_node_);
+                nb_launched_simulations_++;
+                nb_pending_simulations_++;
+                return root_node_;
+            }
+
+            // The considered moves are ranked once all the simulations of the phase are completed.
+            if (phase_is_complete())
+            {
+                if (nb_pending_simulations_ > 0)
+                {
+                    return nullptr;
+                }
+                halve();
+                continue;
+            }
+
+            // Starts a simulation in the subtree of the next considered move below its visit target.
+            bool has_backpropagated = false;
+            for (std::size_t k = 0; k < considered_.size() && !has_backpropagated; k++)
+            {
+                int i = considered_[next_considered_];
+                next_considered_ = (next_considered_ + 1) % considered_.size();
+
+                Node *child = root_node_->children[i];
+                if (child->visits + child->virtual_loss >= target_visits_[i])
+                {
+                    continue;
+                }
+
+                Node *selected_node = select(child);
+
+                // Already expanded terminal nodes are backpropagated with their stored value.
+                if (selected_node->is_expanded)
+                {
+                    backpropagate(selected_node, selected_node->value);
+                    nb_launched_simulations_++;
+                    has_backpropagated = true;
+                    continue;
+                }
+
+                // The selection reached a leaf already waiting for its evaluation: try the subtree of another move.
+                if (selected_node->evaluation_pending)
+                {
+                    continue;
+                }
+
+                begin_evaluation(selected_node);
+                nb_launched_simulations_++;
+                nb_pending_simulations_++;
+                return selected_node;
+            }
+
+            // Every subtree below its visit target waits for its suspended simulations.
+            if (!has_backpropagated)
+            {
+                return nullptr;
+            }
+        }
+        return nullptr;
+    }
+
+    void GumbelSearch::complete(Node *leaf, const Evaluation &evaluation)
+    {
+        complete_evaluation(leaf, evaluation);
+        nb_pending_simulations_--;
+
+        if (!is_started_ && root_node_->is_expanded)
+        {
+            start_search();
+        }
+    }
+
+    bool GumbelSearch::is_finished() const
+    {
+        return nb_pending_simulations_ == 0 && is_started_ && (halving_is_over_ || nb_launched_simulations_ >= nb_simulations_);
+    }
+
+    void GumbelSearch::interrupt()
+    {
+        halving_is_over_ = true;
+    }
+
+    Node *GumbelSearch::selected_child() const
+    {
+        if (considered_.empty())
+        {
+            return nullptr;
+        }
+
+        int best = considered_[0];
+        float best_score = score(best);
+        for (int i : considered_)
+        {
+            float current_score = score(i);
+            if (current_score > best_score)
+            {
+                best = i;
+                best_score = current_score;
+            }
+        }
+        return root_node_->children[best];
+    }
+
+    torch::Tensor GumbelSearch::improved_policy() const
+    {
+        torch::Tensor policy = torch::zeros({game::MAX_MVTS});
+        auto policy_accessor = policy.accessor<float, 1>();
+
+        int nb_children = root_node_->children.size();
+        if (!is_started_ || nb_children == 0)
+        {
+            return policy;
+        }
+
+        // Softmax of the logits plus the transformed completed Q-values.
+        std::vector<float> logits(nb_children);
+        for (int i = 0; i < nb_children; i++)
+        {
+            logits[i] = log_priors_[i] + sigma(completed_q(root_node_->children[i]));
+        }
+        float max_logit = *std::max_element(logits.begin(), logits.end());
+
+        float sum = 0.0;
+        for (int i = 0; i < nb_children; i++)
+        {
+            logits[i] = std::exp(logits[i] - max_logit);
+            sum += logits[i];
+        }
+        for (int i = 0; i < nb_children; i++)
+        {
+            policy_accessor[root_node_->children[i]->move.index] = logits[i] / sum;
+        }
+
+        return policy;
+    }
+
+    void GumbelSearch::start_search()
+    {
+        is_started_ = true;
+
+        int nb_children = root_node_->children.size();
+        gumbel_.assign(nb_children, 0.0);
+        log_priors_.resize(nb_children);
+
+        std::extreme_value_distribution<float> gumbel_distribution(0.0, 1.0);
+        for (int i = 0; i < nb_children; i++)
+        {
+            log_priors_[i] = std::log(std::max(root_node_->children[i]->prior, std::numeric_limits<float>::min()));
+            if (add_noise_)
+            {
+                gumbel_[i] = gumbel_distribution(gen_);
+            }
+        }
+
+        // The considered moves are the best ones according to the perturbed policy.
+        considered_.resize(nb_children);
+        for (int i = 0; i < nb_children; i++)
+        {
+            considered_[i] = i;
+        }
+        int nb_considered = std::min(nb_children, GUMBEL_NUM_CONSIDERED_ACTIONS);
+        std::partial_sort(considered_.begin(), considered_.begin() + nb_considered, considered_.end(), [this](int a, int b)
+                          { return gumbel_[a] + log_priors_[a] > gumbel_[b] + log_priors_[b]; });
+        considered_.resize(nb_considered);
+
+        // Terminal root, or a single legal move: there is nothing to search.
+        if (nb_considered <= 1)
+        {
+            halving_is_over_ = true;
+            return;
+        }
+
+        // Each phase halves the considered moves, until one of them is left.
+        nb_phases_ = 0;
+        while ((1 << nb_phases_) < nb_considered)
+        {
+            nb_phases_++;
+        }
+        phase_ = 0;
+        target_visits_.assign(nb_children, 0);
+        start_phase();
+    }
+
+    void GumbelSearch::start_phase()
+    {
+        // The remaining simulations are shared evenly between the remaining phases, and between the moves of a phase.
+        int nb_remaining_simulations = nb_simulations_ - nb_launched_simulations_;
+        int nb_remaining_phases = std::max(1, nb_phases_ - phase_);
+        int nb_visits = std::max(1, nb_remaining_simulations / (nb_remaining_phases * static_cast<int>(considered_.size())));
+
+        for (int i : considered_)
+        {
+            target_visits_[i] = root_node_->children[i]->visits + nb_visits;
+        }
+        next_considered_ = 0;
+    }
+
+    bool GumbelSearch::phase_is_complete() const
+    {
+        for (int i : considered_)
+        {
+            Node *child = root_node_->children[i];
+            if (child->visits + child->virtual_loss < target_visits_[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void GumbelSearch::halve()
+    {
+        std::vector<float> scores(root_node_->children.size());
+        for (int i : considered_)
+        {
+            scores[i] = score(i);
+        }
+        std::sort(considered_.begin(), considered_.end(), [&scores](int a, int b)
+                  { return scores[a] > scores[b]; });
+        considered_.resize((considered_.size() + 1) / 2);
+        phase_++;
+
+        if (considered_.size() <= 1)
+        {
+            halving_is_over_ = true;
+            return;
+        }
+        start_phase();
+    }
+
+    float GumbelSearch::mixed_value() const
+    {
+        // The value of the root is given for yellow, the Q-values of its children for the player of the root.
+        float root_value = (root_node_->state.yellow_is_playing) ? root_node_->value : -root_node_->value;
+
+        int sum_visits = 0;
+        float sum_priors = 0.0;
+        float sum_weighted_q = 0.0;
+        for (Node *child : root_node_->children)
+        {
+            if (child->visits > 0)
+            {
+                sum_visits += child->visits;
+                sum_priors += child->prior;
+                sum_weighted_q += child->prior * child->wins / child->visits;
+            }
+        }
+
+        if (sum_visits == 0 || sum_priors <= 0.0)
+        {
+            return root_value;
+        }
+        return (root_value + sum_visits * sum_weighted_q / sum_priors) / (1 + sum_visits);
+    }
+
+    float GumbelSearch::completed_q(const Node *child) const
+    {
+        return (child->visits > 0) ? child->wins / child->visits : mixed_value();
+    }
+
+    float GumbelSearch::sigma(float q) const
+    {
+        int max_visits = 0;
+        for (Node *child : root_node_->children)
+        {
+            max_visits = std::max(max_visits, child->visits);
+        }
+
+        // The Q-values in [-1, 1] are rescaled to [0, 1].
+        return (GUMBEL_C_VISIT + max_visits) * GUMBEL_C_SCALE * (q + 1.0) / 2.0;
+    }
+
+    float GumbelSearch::score(int i) const
+    {
+        return gumbel_[i] + log_priors_[i] + sigma(completed_q(root_node_->children[i]));
+    }
+
+    Node *run_gumbel_search(Node *root_node, InferenceServer &server, int nb_simulations, int max_in_flight, std::mt19937 &gen, bool add_noise)
+    {
+        GumbelSearch search(root_node, nb_simulations, max_in_flight, gen, add_noise);
+
+        SimulationScheduler scheduler(server, max_in_flight);
+        scheduler.add(&search);
+        scheduler.run_until_finished();
+
+        return search.selected_child();
+    }
+}
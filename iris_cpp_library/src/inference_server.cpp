@@ -0,0 +1,287 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <utility>
+#include <vector>
+#include <torch/torch.h>
+#include <torch/script.h>
+#include "utils.hpp"
+#include "iris_zero/evaluation_cache.hpp"
+#include "iris_zero/inference_server.hpp"
+#include "iris_zero/iris_zero_search.hpp"
+
+// Implementation of the 'InferenceServer' class, see 'include/iris_zero/inference_server.hpp'.
+namespace iris_zero
+{
+    InferenceServer::InferenceServer(
+        Model model,
+        int max_batch_size,
+        std::chrono::microseconds max_wait,
+        int cache_size) : model_(model),
+                          max_batch_size_(std::max(1, max_batch_size)),
+                          max_wait_(max_wait),
+                          cache_((cache_size > 0) ? std::make_unique<EvaluationCache>(cache_size) : nullptr),
+                          batch_buffer_(torch::empty({max_batch_size_, game::NUMBER_REAL_NODES, NUMBER_ATRIBUTES})),
+                          head_(&stub_),
+                          tail_(&stub_),
+                          stub_(),
+                          is_sleeping_(false),
+                          stop_(false),
+                          nb_batches_(0),
+                          nb_evaluations_(0)
+    {
+        stub_.next.store(nullptr);
+        thread_ = std::thread(&InferenceServer::serve, this);
+    }
+
+    InferenceServer::~InferenceServer()
+    {
+        stop_ = true;
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            wake_condition_.notify_one();
+        }
+        thread_.join();
+    }
+
+    std::future<Evaluation> InferenceServer::submit(const game::GameState &state)
+    {
+        Request *request = new Request();
+        request->state = state;
+        request->planes = nullptr;
+        request->use_cache = false;
+        return submit(request);
+    }
+
+    std::future<Evaluation> InferenceServer::submit(const float *planes)
+    {
+        Request *request = new Request();
+        request->planes = planes;
+        request->use_cache = false;
+        return submit(request);
+    }
+
+    std::future<Evaluation> InferenceServer::submit(const float *planes, const game::GameState &state)
+    {
+        if (!cache_)
+        {
+            return submit(planes);
+        }
+
+        // The position is canonicalized by the submitting thread, and its evaluation stored by the server thread.
+        Request *request = new Request();
+        request->planes = planes;
+        request->use_cache = true;
+        request->canonical = game::canonicalize(state);
+
+        Evaluation evaluation;
+        if (cache_->find(request->canonical, evaluation))
+        {
+            std::promise<Evaluation> promise;
+            promise.set_value(evaluation);
+            delete request;
+            return promise.get_future();
+        }
+        return submit(request);
+    }
+
+    std::future<Evaluation> InferenceServer::submit(Request *request)
+    {
+        std::future<Evaluation> future = request->promise.get_future();
+
+        push(request);
+
+        // Wake the server thread up if it is waiting for requests. The mutex is only taken in that case.
+        if (is_sleeping_.load())
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            wake_condition_.notify_one();
+        }
+
+        return future;
+    }
+
+    float InferenceServer::average_batch_size() const
+    {
+        long nb_batches = nb_batches_.load();
+        return (nb_batches > 0) ? static_cast<float>(nb_evaluations_.load()) / nb_batches : 0.0;
+    }
+
+    float InferenceServer::cache_hit_rate() const
+    {
+        return (cache_) ? cache_->hit_rate() : 0.0;
+    }
+
+    void InferenceServer::push(Request *request)
+    {
+        request->next.store(nullptr, std::memory_order_relaxed);
+
+        // Swing the head to the new request, then link the previous head to it. Between these two steps
+        // the request is not reachable yet from the tail: 'pop' sees the queue as momentarily empty.
+        Request *previous = head_.exchange(request, std::memory_order_acq_rel);
+        previous->next.store(request, std::memory_order_release);
+    }
+
+    InferenceServer::Request *InferenceServer::pop()
+    {
+        Request *tail = tail_;
+        Request *next = tail->next.load(std::memory_order_acquire);
+
+        // Skip the stub request.
+        if (tail == &stub_)
+        {
+            if (next == nullptr)
+            {
+                return nullptr;
+            }
+            tail_ = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+
+        if (next != nullptr)
+        {
+            tail_ = next;
+            return tail;
+        }
+
+        // The tail is the last linked request: a producer may be in the middle of a push.
+        if (tail != head_.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+
+        // Put the stub back behind the last request, so that it can be popped.
+        push(&stub_);
+
+        next = tail->next.load(std::memory_order_acquire);
+        if (next != nullptr)
+        {
+            tail_ = next;
+            return tail;
+        }
+        return nullptr;
+    }
+
+    InferenceServer::Request *InferenceServer::wait_request()
+    {
+        while (true)
+        {
+            Request *request = pop();
+            if (request != nullptr)
+            {
+                return request;
+            }
+            if (stop_)
+            {
+                return nullptr;
+            }
+
+            // The queue is checked again after announcing the sleep, under the mutex: a producer either sees
+            // the flag and notifies, or pushed its request before the check.
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            is_sleeping_ = true;
+            request = pop();
+            if (request == nullptr && !stop_)
+            {
+                // The timeout covers a producer caught between the two steps of its push.
+                wake_condition_.wait_for(lock, std::chrono::milliseconds(1));
+            }
+            is_sleeping_ = false;
+
+            if (request != nullptr)
+            {
+                return request;
+            }
+        }
+    }
+
+    void InferenceServer::evaluate_batch(std::vector<Request *> &batch)
+    {
+        std::vector<Evaluation> evaluations;
+        bool is_evaluated = false;
+        try
+        {
+            // Encode the positions into the first rows of the batch buffer, or copy them if they are already encoded.
+            const int state_size = game::NUMBER_REAL_NODES * NUMBER_ATRIBUTES;
+            float *planes = batch_buffer_.data_ptr<float>();
+            for (int k = 0; k < static_cast<int>(batch.size()); k++)
+            {
+                if (batch[k]->planes != nullptr)
+                {
+                    std::memcpy(planes + k * state_size, batch[k]->planes, sizeof(float) * state_size);
+                }
+                else
+                {
+                    encode_game_state(batch[k]->state, planes + k * state_size);
+                }
+            }
+
+            evaluations = batch_position_evaluation(batch_buffer_.narrow(0, 0, batch.size()), model_);
+            is_evaluated = true;
+        }
+        catch (...)
+        {
+            // Forward the error to every search thread waiting on this batch.
+            for (Request *request : batch)
+            {
+                request->promise.set_exception(std::current_exception());
+            }
+        }
+
+        // The promises are only fulfilled once the whole forward pass has succeeded, so that none is fulfilled twice.
+        if (is_evaluated)
+        {
+            for (int k = 0; k < static_cast<int>(batch.size()); k++)
+            {
+                if (batch[k]->use_cache)
+                {
+                    cache_->insert(batch[k]->canonical, evaluations[k]);
+                }
+                batch[k]->promise.set_value(evaluations[k]);
+            }
+        }
+
+        nb_batches_++;
+        nb_evaluations_ += batch.size();
+
+        for (Request *request : batch)
+        {
+            delete request;
+        }
+        batch.clear();
+    }
+
+    void InferenceServer::serve()
+    {
+        std::vector<Request *> batch;
+        batch.reserve(max_batch_size_);
+
+        while (Request *first_request = wait_request())
+        {
+            batch.push_back(first_request);
+
+            // Gather more requests until the batch is full or the waiting time is over.
+            auto deadline = std::chrono::steady_clock::now() + max_wait_;
+            while (static_cast<int>(batch.size()) < max_batch_size_)
+            {
+                Request *request = pop();
+                if (request != nullptr)
+                {
+                    batch.push_back(request);
+                }
+                else if (std::chrono::steady_clock::now() < deadline)
+                {
+                    std::this_thread::yield();
+                }
+                else
+                {
+                    break;
+                }
+            }
+
+            evaluate_batch(batch);
+        }
+    }
+}
@@ -0,0 +1,189 @@
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "game/initial_board.hpp"
+#include "game/symmetry.hpp"
+
+// Implementation of the initial board generation, see 'include/game/initial_board.hpp'.
+namespace game
+{
+    // Orders of the tile types on a ring, computed once.
+    struct LayoutTables
+    {
+        // Tile type of each of the five nodes of a ring, for each order.
+        int types[NUMBER_RING_LAYOUTS][5];
+
+        // Index of each order, given its tile types as a number in base 5 (-1 if it is not an order).
+        int indexes[3125];
+
+        LayoutTables()
+        {
+            std::fill(indexes, indexes + 3125, -1);
+            int order[5] = {0, 1, 2, 3, 4};
+            int index = 0;
+            do
+            {
+                int code = 0;
+                for (int k = 0; k < 5; k++)
+                {
+                    types[index][k] = order[k];
+                    code = 5 * code + order[k];
+                }
+                indexes[code] = index;
+                index++;
+            } while (std::next_permutation(order, order + 5));
+        }
+    };
+
+    // Returns the order tables, built on first use.
+    const LayoutTables &layout_tables()
+    {
+        static const LayoutTables tables;
+        return tables;
+    }
+
+    GameState layout_initial_state(int layout)
+    {
+        GameState state = {true, 0, 0, 0, 0, 0, 0, 0, 0, 0, true, true, true, 0, 0, 0};
+
+        const LayoutTables &tables = layout_tables();
+        for (int ring = 3; ring >= 0; ring--)
+        {
+            const int *types = tables.types[layout % NUMBER_RING_LAYOUTS];
+            layout /= NUMBER_RING_LAYOUTS;
+            for (int k = 0; k < 5; k++)
+            {
+                int bit = 1 << (5 * ring + k + 1);
+                state.yellow_colors |= (types[k] == 0 || types[k] == 1 || types[k] == 4) ? bit : 0;
+                state.red_colors |= (types[k] == 2 || types[k] == 3 || types[k] == 4) ? bit : 0;
+                state.black_colors |= (types[k] == 0 || types[k] == 2) ? bit : 0;
+                state.white_colors |= (types[k] == 1 || types[k] == 3) ? bit : 0;
+            }
+        }
+        return state;
+    }
+
+    int initial_state_layout(const GameState &state)
+    {
+        const LayoutTables &tables = layout_tables();
+        int layout = 0;
+        for (int ring = 0; ring < 4; ring++)
+        {
+            int code = 0;
+            for (int k = 0; k < 5; k++)
+            {
+                int node = 5 * ring + k + 1;
+                bool yellow = (state.yellow_colors >> node) & 1;
+                bool red = (state.red_colors >> node) & 1;
+                bool black = (state.black_colors >> node) & 1;
+                int type = (yellow && red) ? 4 : 2 * red + !black;
+                code = 5 * code + type;
+            }
+            if (tables.indexes[code] < 0)
+            {
+                throw std::runtime_error("The rings of the board do not hold one tile of each type");
+            }
+            layout = NUMBER_RING_LAYOUTS * layout + tables.indexes[code];
+        }
+        return layout;
+    }
+
+    GameState random_initial_state(std::mt19937 &gen)
+    {
+        std::uniform_int_distribution<int> layout_distribution(0, NUMBER_LAYOUTS - 1);
+        return layout_initial_state(layout_distribution(gen));
+    }
+
+    GameState random_initial_state(unsigned int seed)
+    {
+        std::mt19937 gen(seed);
+        return random_initial_state(gen);
+    }
+
+    // Orders of the tiles of the rings after the canonical transformations (see 'canonicalize'), computed once.
+    // The transformations are applied to game states, so that the layouts follow the conventions of
+    // 'transform_game_state'.
+    struct RingTransformationTables
+    {
+        // Order of the tiles of each ring after each transformation, for each order.
+        int orders[NUMBER_CANONICAL_SYMMETRIES][4][NUMBER_RING_LAYOUTS];
+
+        RingTransformationTables()
+        {
+            // The board automorphisms send every ring to itself, so each ring is transformed with the other rings
+            // holding the first order.
+            int ring_factors[4] = {NUMBER_RING_LAYOUTS * NUMBER_RING_LAYOUTS * NUMBER_RING_LAYOUTS,
+                                   NUMBER_RING_LAYOUTS * NUMBER_RING_LAYOUTS,
+                                   NUMBER_RING_LAYOUTS,
+                                   1};
+            for (int transformation = 0; transformation < NUMBER_CANONICAL_SYMMETRIES; transformation++)
+            {
+                for (int ring = 0; ring < 4; ring++)
+                {
+                    for (int order = 0; order < NUMBER_RING_LAYOUTS; order++)
+                    {
+                        GameState state = transform_game_state(layout_initial_state(order * ring_factors[ring]), transformation);
+                        orders[transformation][ring][order] = (initial_state_layout(state) / ring_factors[ring]) % NUMBER_RING_LAYOUTS;
+                    }
+                }
+            }
+        }
+    };
+
+    // Returns the transformation tables, built on first use.
+    const RingTransformationTables &ring_transformation_tables()
+    {
+        static const RingTransformationTables tables;
+        return tables;
+    }
+
+    // Appends the smallest layouts of their classes starting with a given prefix (the orders of the first rings).
+    // 'transformations' holds the transformations leaving the prefix unchanged: the other ones send every layout with
+    // this prefix to a larger one.
+    void append_distinct_layouts(int ring, int prefix, int transformations, std::vector<int> &layouts)
+    {
+        const RingTransformationTables &tables = ring_transformation_tables();
+        for (int order = 0; order < NUMBER_RING_LAYOUTS; order++)
+        {
+            bool is_smallest = true;
+            int fixing_transformations = 0;
+            for (int bits = transformations; bits != 0; bits &= bits - 1)
+            {
+                int transformation = __builtin_ctz(bits);
+                int transformed_order = tables.orders[transformation][ring][order];
+                if (transformed_order < order)
+                {
+                    is_smallest = false;
+                    break;
+                }
+                if (transformed_order == order)
+                {
+                    fixing_transformations |= 1 << transformation;
+                }
+            }
+            if (!is_smallest)
+            {
+                continue;
+            }
+
+            int layout = NUMBER_RING_LAYOUTS * prefix + order;
+            if (ring == 3)
+            {
+                layouts.push_back(layout);
+            }
+            else
+            {
+                append_distinct_layouts(ring + 1, layout, fixing_transformations, layouts);
+            }
+        }
+    }
+
+    std::vector<int> distinct_layouts()
+    {
+        // Every transformation but the identity leaves the empty prefix unchanged.
+        std::vector<int> layouts;
+        append_distinct_layouts(0, 0, ((1 << NUMBER_CANONICAL_SYMMETRIES) - 1) & ~1, layouts);
+        return layouts;
+    }
+}
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -6,100 +9,106 @@
 #include <cmath>
 #include <memory>
 #include <chrono>
+#include <limits>
+#include <iostream>
+#include <stdexcept>
 #include <torch/torch.h>
 #include <torch/script.h>
 #include "utils.hpp"
 #include "game/rules.hpp"
 #include "iris_zero/iris_zero_bot.hpp"
-#include "iris_zero/iris_zero_training.hpp"
+#include "iris_zero/iris_zero_search.hpp"
 #include "iris_zero/iris_zero_constants.hpp"
+#include "iris_zero/inference_server.hpp"
+#include "iris_zero/model.hpp"
+#include "iris_zero/native_network.hpp"
+#include "iris_zero/simulation_scheduler.hpp"
+#include "iris_zero/gumbel_search.hpp"
 
-// Implementation of 'iris_zero', see 'include/iris_zero/iris_zero_bot.hpp' and 'include/iris_zero/iris_zero_training.hpp'.
+// Implementation of 'iris_zero', see 'include/iris_zero/iris_zero_bot.hpp' and 'include/iris_zero/iris_zero_search.hpp'.
 namespace iris_zero
 {
-    // Evaluates the game's position using a neural network model, returning a pair of policy and value.
-    // Takes as input the tensor of the position to be evaluated, and the loaded TorchScript module.
-    std::pair<torch::Tensor, float> position_evaluation(const torch::Tensor &state_tensor, torch::jit::script::Module module)
+    // Loads a model, run by the native engine if the file holds exported native weights, and by TorchScript otherwise.
+    // Reports the failure before rethrowing the error.
+    Model load_model(const std::string &model_path)
     {
-        torch::Tensor input = state_tensor.unsqueeze(0);
-        std::vector<torch::jit::IValue> inputs = {input};
-
-        torch::NoGradGuard no_grad;
-        torch::jit::IValue output = module.forward(inputs);
-
-        auto output_tuple = output.toTuple();
-
-        torch::Tensor policy_logit = output_tuple->elements()[0].toTensor().squeeze(0);
-        float value = output_tuple->elements()[1].toTensor()[0][0].item<float>();
-
-        torch::Tensor policy = torch::softmax(policy_logit, 0);
+        if (is_native_model_file(model_path))
+        {
+            try
+            {
+                return Model(std::make_shared<const NativeNetwork>(model_path));
+            }
+            catch (const std::runtime_error &e)
+            {
+                std::cerr << "Error loading the model\n";
+                throw;
+            }
+        }
 
-        return std::make_pair(policy, value);
+        torch::jit::script::Module module;
+        try
+        {
+            module = torch::jit::load(model_path);
+        }
+        catch (const c10::Error &e)
+        {
+            std::cerr << "Error loading the model\n";
+            throw e;
+        }
+        return Model(module);
     }
 
-    // Represents a single node in the search tree of the AlphaZero MCTS algorithm.
-    struct Node
+    // Evaluates the game's position using a neural network model, returning a pair of policy logits and value.
+    // Takes as input the tensor of the position to be evaluated, and the loaded model.
+    std::pair<torch::Tensor, float> position_evaluation(const torch::Tensor &state_tensor, Model model)
     {
-        // The game state that this node represents.
-        game::GameState state;
-
-        // Tensor representation of the game state, suitable for neural network processing.
-        torch::Tensor state_tensor;
-
-        // Unique index representing the specific move taken from the parent node to reach this current node.
-        int idx_;
-
-        // Number of times this node has been visited.
-        int visits;
-
-        // Sum of the outputs of the values of the positions evaluated by the model in this node's subtree.
-        float wins;
+        auto [policies, values] = model.evaluate(state_tensor.unsqueeze(0));
 
-        // Predicted value (expected outcome) of this GameSate, as given by the neural network.
-        float value;
+        torch::Tensor policy_logits = policies.squeeze(0);
+        float value = values.data_ptr<float>()[0];
 
-        // Flag indicating whether this node has been expanded (i.e., all its possible children have been generated).
-        bool is_expanded;
-
-        // Pointer to the parent node in the search tree.
-        Node *parent;
+        return std::make_pair(policy_logits, value);
+    }
 
-        // List of pointers to the child nodes.
-        std::vector<Node *> children;
+    // Batched version of 'position_evaluation': stacks the position tensors and runs a single forward pass.
+    std::vector<std::pair<torch::Tensor, float>> batch_position_evaluation(const std::vector<torch::Tensor> &state_tensors, Model model)
+    {
+        if (state_tensors.empty())
+        {
+            return std::vector<std::pair<torch::Tensor, float>>();
+        }
+        return batch_position_evaluation(torch::stack(state_tensors, 0), model);
+    }
 
-        // Probability distribution over moves, as given by the neural network's policy head.
-        torch::Tensor policy;
+    // Batched version of 'position_evaluation' on already stacked positions, with a single forward pass.
+    std::vector<std::pair<torch::Tensor, float>> batch_position_evaluation(const torch::Tensor &states_tensor, Model model)
+    {
+        std::vector<std::pair<torch::Tensor, float>> evaluations;
+        int batch_size = states_tensor.size(0);
+        if (batch_size == 0)
+        {
+            return evaluations;
+        }
 
-        Node(
-            game::GameState state,
-            int idx = 0,
-            Node *parent = nullptr) : state(state),
-                                      idx_(idx),
-                                      parent(parent),
-                                      visits(0),
-                                      wins(0.0),
-                                      value(0.0),
-                                      is_expanded(false),
-                                      children(),
-                                      state_tensor(),
-                                      policy() {}
+        auto [policies, values] = model.evaluate(states_tensor);
+        auto values_accessor = values.accessor<float, 2>();
 
-        ~Node()
+        evaluations.reserve(batch_size);
+        for (int k = 0; k < batch_size; k++)
         {
-            for (Node *child : children)
-            {
-                delete child;
-            }
+            evaluations.emplace_back(policies[k], values_accessor[k][0]);
         }
-    };
 
+        return evaluations;
+    }
+
+    // Mixes dirichlet noise into the priors of the node's children, see AlphaZero paper.
     void add_dirichlet_noise(Node *node, std::mt19937 &gen)
     {
         int size = node->children.size();
         std::vector<float> samples(size);
 
         std::gamma_distribution<> gamma_dist(ALPHA_DIRICHLET, 1.0);
-        auto root_policy_accessor = node->policy.accessor<float, 1>();
 
         float sum = 0.0;
         for (int i = 0; i < size; ++i)
@@ -112,16 +121,19 @@ namespace iris_zero
         int idx = 0;
         for (Node *child : node->children)
         {
-            root_policy_accessor[child->idx_] = 0.75 * root_policy_accessor[child->idx_] + 0.25 * samples[idx] / sum;
+            child->prior = 0.75 * child->prior + 0.25 * samples[idx] / sum;
             idx++;
         }
     }
 
     // Calculates the PUCT value for a node, used to determine optimal nodes to explore in the AlphaZero search algorithm.
+    // Pending evaluations count as visits lost by the player choosing this node (virtual losses).
     float puctValue(Node *node)
     {
-        float q = (node->visits > 0) ? node->wins / node->visits : 0.0;
-        float u = node->parent->policy[node->idx_].item<float>() * sqrt(PUCT_PARAMETER * (node->parent->visits - 1)) / (node->visits + 1);
+        int visits = node->visits + node->virtual_loss;
+        int parent_visits = node->parent->visits + node->parent->virtual_loss;
+        float q = (visits > 0) ? (node->wins - node->virtual_loss) / visits : 0.0;
+        float u = node->prior * sqrt(PUCT_PARAMETER * (parent_visits - 1)) / (visits + 1);
         return u + q;
     }
 
@@ -156,7 +168,23 @@ namespace iris_zero
 
     // Expands a node by computing its value and policy according to the model, 
     // and add all possible following states to the tree if the node is not termial.
-    void expand(Node *node, torch::jit::script::Module module)
+    void expand(Node *node, Model model)
+    {
+        if (node->is_expanded)
+        {
+            return;
+        }
+
+        encode_node(node);
+        torch::Tensor state_tensor = torch::from_blob(node->planes.data(), {game::NUMBER_REAL_NODES, NUMBER_ATRIBUTES});
+        auto [policy_logits, value] = position_evaluation(state_tensor, model);
+        expand(node, policy_logits, value);
+    }
+
+    // Sets the model evaluation of a node, and add all possible following states to the tree if the node is not termial.
+    // The children are created from the legal moves mask, and their priors are the softmax of the policy logits over
+    // the legal moves, computed in the same pass.
+    void expand(Node *node, const torch::Tensor &policy_logits, float value)
     {
         if (node->is_expanded)
         {
@@ -164,10 +192,6 @@ namespace iris_zero
         }
         node->is_expanded = true;
 
-        torch::Tensor state_tensor = game_state_to_tensor(node->state);
-        node->state_tensor = state_tensor;
-        auto [policy, value] = position_evaluation(node->state_tensor, module);
-        node->policy = policy;
         node->value = value;
 
         if (game::exists_winner(node->state))
@@ -175,10 +199,34 @@ namespace iris_zero
             return;
         }
 
-        for (const std::pair<int, game::GameState> &move : game::MoveGenerator(node->state))
+        torch::Tensor contiguous_logits = policy_logits.contiguous();
+        const float *logits = contiguous_logits.data_ptr<float>();
+
+        // Creates a child per legal move, in the order of the move indexes, and finds the largest legal logit.
+        // The rules of the side to move are chosen once for all the children.
+        std::uint64_t legal_moves = game::legal_moves_mask(node->state);
+        auto apply_move = (node->state.yellow_is_playing) ? &game::apply_move<true> : &game::apply_move<false>;
+        node->children.reserve(__builtin_popcountll(legal_moves));
+        float max_logit = std::numeric_limits<float>::lowest();
+        while (legal_moves != 0)
         {
-            Node *new_node = new Node(move.second, move.first, node);
-            node->children.push_back(new_node);
+            int move = __builtin_ctzll(legal_moves);
+            legal_moves &= legal_moves - 1;
+
+            node->children.push_back(new Node(apply_move(node->state, move), game::Move(move), node));
+            max_logit = std::max(max_logit, logits[move]);
+        }
+
+        // Softmax over the legal moves, written in the children's priors.
+        float sum = 0.0;
+        for (Node *child : node->children)
+        {
+            child->prior = std::exp(logits[child->move.index] - max_logit);
+            sum += child->prior;
+        }
+        for (Node *child : node->children)
+        {
+            child->prior /= sum;
         }
     }
 
@@ -193,6 +241,53 @@ namespace iris_zero
         }
     }
 
+    // Adds 'count' virtual losses (removes them if negative) on the path from the node to the root.
+    void add_virtual_loss(Node *node, int count)
+    {
+        while (node != nullptr)
+        {
+            node->virtual_loss += count;
+            node = node->parent;
+        }
+    }
+
+    // Computes the network input of a node, with a delta from its parent's one when it is available.
+    void encode_node(Node *node)
+    {
+        if (!node->planes.empty())
+        {
+            return;
+        }
+        node->planes.resize(game::NUMBER_REAL_NODES * NUMBER_ATRIBUTES);
+
+        if (node->parent != nullptr && !node->parent->planes.empty())
+        {
+            encode_game_state_delta(node->parent->state, node->parent->planes.data(), node->state, node->planes.data());
+        }
+        else
+        {
+            encode_game_state(node->state, node->planes.data());
+        }
+    }
+
+    // Marks a selected leaf as waiting for its evaluation.
+    void begin_evaluation(Node *leaf)
+    {
+        leaf->evaluation_pending = true;
+        encode_node(leaf);
+        add_virtual_loss(leaf, 1);
+    }
+
+    // Completes the simulation of a leaf with its evaluation.
+    void complete_evaluation(Node *leaf, const Evaluation &evaluation)
+    {
+        add_virtual_loss(leaf, -1);
+        leaf->evaluation_pending = false;
+
+        expand(leaf, evaluation.first, evaluation.second);
+        backpropagate(leaf, leaf->value);
+    }
+
     // Takes a Node, and returns its policy (distribution of explored following moves) after the search.
     torch::Tensor node_mcts_policy(Node *node)
     {
@@ -201,7 +296,7 @@ namespace iris_zero
 
         for (Node *child : node->children)
         {
-            node_policy_accessor[child->idx_] = static_cast<float>(child->visits) / (node->visits - 1);
+            node_policy_accessor[child->move.index] = static_cast<float>(child->visits) / (node->visits - 1);
         }
 
         return node_policy;
@@ -243,7 +338,7 @@ namespace iris_zero
         for (Node *child : root_node->children)
         {
             // The 1 in the pow function is used here as a temperature parameter.
-            float smoothed_value = pow(root_policy_accessor[child->idx_], 1);
+            float smoothed_value = pow(root_policy_accessor[child->move.index], 1);
             sum += smoothed_value;
 
             float random_float = uniform_dist(gen);
@@ -259,182 +354,208 @@ namespace iris_zero
         return std::make_pair(idx_best, best_exp_child);
     }
 
-    // This internal function takes as input an initial gamestate, a model, and generates a training sample from it.
-    // A training sample is a tuple of (posion tensor, policy tensor, value tensor) from a self-played game with the constants defined in 'constants.cpp'.
-    std::tuple<torch::Tensor, torch::Tensor, torch::Tensor> generate_training_sample_int(const game::GameState &state, const std::string &model_path)
+    // Internal function implementing the full AlphaZero playing algorithm with a time limit.
+    std::pair<int, int> iris_zero_bot_time_int(const game::GameState &state, float reflexion_time, const std::string &model_path)
     {
-        std::random_device rd;
-        std::mt19937 gen(rd());
+        InferenceServer server(load_model(model_path), MAX_EVALUATIONS_IN_FLIGHT, std::chrono::microseconds(INFERENCE_MAX_WAIT_MICROSECONDS), INFERENCE_CACHE_SIZE);
 
-        torch::jit::script::Module module;
-        try
-        {
-            module = torch::jit::load(model_path);
-        }
-        catch (const c10::Error &e)
-        {
-            std::cerr << "Error loading the model\n";
-            throw e;
-        }
+        Node *root_node = new Node(state);
 
-        std::vector<torch::Tensor> game_state_recoder;
-        std::vector<torch::Tensor> game_policy_recorder;
+        run_simulations(root_node, server, std::numeric_limits<int>::max(), reflexion_time, MAX_EVALUATIONS_IN_FLIGHT);
 
-        Node *root_node = new Node(state);
-        int turn = 0;
+        auto best_move = next_move_best(root_node);
+        auto result = game::move_to_python_format(root_node->state, best_move.second->move);
 
-        while (turn < MAX_NB_TURN_SAMPLE && !game::exists_winner(root_node->state))
-        {
-            if (!root_node->is_expanded)
-            {
-                expand(root_node, module);
-                backpropagate(root_node, root_node->value);
-            }
+        delete root_node;
 
-            add_dirichlet_noise(root_node, gen);
+        return result;
+    }
 
-            while (root_node->visits < NUM_SIM_PER_MOVE)
-            {
-                Node *selected_node = select(root_node);
-                expand(selected_node, module);
-                backpropagate(selected_node, selected_node->value);
-            }
-            torch::Tensor root_policy = node_mcts_policy(root_node);
+    // Internal function implementing the full AlphaZero playing algorithm with a maximum number of simulations.
+    std::pair<int, int> iris_zero_bot_sim_int(const game::GameState &state, int nb_simulations, const std::string &model_path)
+    {
+        InferenceServer server(load_model(model_path), MAX_EVALUATIONS_IN_FLIGHT, std::chrono::microseconds(INFERENCE_MAX_WAIT_MICROSECONDS), INFERENCE_CACHE_SIZE);
 
-            game_state_recoder.push_back(root_node->state_tensor);
-            game_policy_recorder.push_back(root_policy);
+        Node *root_node = new Node(state);
 
-            Node *new_root;
-            int idx_new_root;
+        run_simulations(root_node, server, nb_simulations, -1.0, MAX_EVALUATIONS_IN_FLIGHT);
 
-            if (turn <= NUM_TURN_EXP_BEFORE_BEST)
-            {
-                auto res = next_move_best_exp(root_node, root_policy, gen);
-                idx_new_root = res.first;
-                new_root = res.second;
-            }
-            else
-            {
-                auto res = next_move_best(root_node);
-                idx_new_root = res.first;
-                new_root = res.second;
-            }
+        auto best_move = next_move_best(root_node);
 
-            root_node->children[idx_new_root] = nullptr;
-            new_root->parent = nullptr;
-            delete root_node;
-            root_node = new_root;
+        auto result = game::move_to_python_format(root_node->state, best_move.second->move);
 
-            ++turn;
-        }
+        delete root_node;
 
-        float winner = 0.0;
+        return result;
+    }
 
-        if (turn < MAX_NB_TURN_SAMPLE && game::exists_winner(root_node->state))
-        {
-            if (!root_node->is_expanded)
-            {
-                expand(root_node, module);
-                backpropagate(root_node, root_node->value);
-            }
+    // Internal function implementing the AlphaZero playing algorithm with a Gumbel root search and a maximum number of simulations.
+    // The search is deterministic: the considered moves are the ones of highest prior, without Gumbel noise.
+    std::pair<int, int> iris_zero_bot_gumbel_int(const game::GameState &state, int nb_simulations, const std::string &model_path)
+    {
+        InferenceServer server(load_model(model_path), MAX_EVALUATIONS_IN_FLIGHT, std::chrono::microseconds(INFERENCE_MAX_WAIT_MICROSECONDS), INFERENCE_CACHE_SIZE);
+        std::mt19937 gen(0);
 
-            torch::Tensor win_policy = torch::ones({game::MAX_MVTS});
-            win_policy = win_policy / game::MAX_MVTS;
+        Node *root_node = new Node(state);
 
-            game_state_recoder.push_back(root_node->state_tensor);
-            game_policy_recorder.push_back(win_policy);
+        Node *best_child = run_gumbel_search(root_node, server, nb_simulations, MAX_EVALUATIONS_IN_FLIGHT, gen, false);
 
-            if (root_node->state.yellow_is_playing)
-            {
-                winner = -1.0;
-            }
-            else
-            {
-                winner = 1.0;
-            }
-            turn++;
-        }
+        auto result = game::move_to_python_format(root_node->state, best_child->move);
 
         delete root_node;
 
-        torch::Tensor stacked_positions = torch::stack(game_state_recoder, 0);
-        torch::Tensor stacked_policies = torch::stack(game_policy_recorder, 0);
-        torch::Tensor stacked_values = torch::full({turn}, winner);
-
-        return std::make_tuple(stacked_positions, stacked_policies, stacked_values);
+        return result;
     }
 
-    // Internal function implementing the full AlphaZero playing algorithm with a time limit.
-    std::pair<int, int> iris_zero_bot_time_int(const game::GameState &state, float reflexion_time, const std::string &model_path)
+    std::pair<int, int> iris_zero_search_int(
+        const game::GameState &state,
+        int nb_simulations,
+        float reflexion_time,
+        const std::string &model_path,
+        const std::atomic<bool> &stop,
+        const ProgressCallback &progress)
     {
-        torch::jit::script::Module module;
-        try
-        {
-            module = torch::jit::load(model_path);
-        }
-        catch (const c10::Error &e)
+        if (!game::exists_move(state))
         {
-            std::cerr << "Error loading the model\n";
-            throw e;
+            return std::make_pair(-1, -1);
         }
 
-        std::vector<torch::Tensor> game_state_recoder;
-        std::vector<torch::Tensor> game_policy_recorder;
+        InferenceServer server(load_model(model_path), MAX_EVALUATIONS_IN_FLIGHT, std::chrono::microseconds(INFERENCE_MAX_WAIT_MICROSECONDS), INFERENCE_CACHE_SIZE);
 
         Node *root_node = new Node(state);
 
-        auto start_time = std::chrono::high_resolution_clock::now();
-        while (std::chrono::duration_cast<std::chrono::seconds>(std::chrono::high_resolution_clock::now() - start_time).count() < reflexion_time)
+        // The simulations run by chunks of PROGRESS_INTERVAL, the stop flag being checked between them. The first
+        // chunk always runs, so that the root is expanded.
+        auto start_time = std::chrono::steady_clock::now();
+        for (int nb_done = 0; nb_done < nb_simulations; nb_done += PROGRESS_INTERVAL)
         {
-            Node *selected_node = select(root_node);
-            expand(selected_node, module);
-            backpropagate(selected_node, selected_node->value);
+            float remaining_time = (reflexion_time > 0.0) ? reflexion_time : -1.0;
+            if (nb_done > 0)
+            {
+                if (stop)
+                {
+                    break;
+                }
+                if (reflexion_time >= 0.0)
+                {
+                    remaining_time = reflexion_time - std::chrono::duration<float>(std::chrono::steady_clock::now() - start_time).count();
+                    if (remaining_time <= 0.0)
+                    {
+                        break;
+                    }
+                }
+            }
+
+            run_simulations(root_node, server, std::min(PROGRESS_INTERVAL, nb_simulations - nb_done), remaining_time, MAX_EVALUATIONS_IN_FLIGHT);
+
+            if (progress)
+            {
+                progress(game::move_to_python_format(root_node->state, next_move_best(root_node).second->move));
+            }
         }
 
         auto best_move = next_move_best(root_node);
-        auto result = move_to_python_format(root_node->state, best_move.second->state);
+        auto result = game::move_to_python_format(root_node->state, best_move.second->move);
 
         delete root_node;
 
         return result;
     }
 
-    // Internal function implementing the full AlphaZero playing algorithm with a maximum number of simulations.
-    std::pair<int, int> iris_zero_bot_sim_int(const game::GameState &state, int nb_simulations, const std::string &model_path)
+    // A Gumbel search interrupted once 'stop' is set or 'reflexion_time' seconds have elapsed (a negative
+    // 'reflexion_time' means no time limit), and reporting the move it would select every PROGRESS_INTERVAL simulations.
+    class InterruptibleGumbelSearch : public SearchTask
     {
-        torch::jit::script::Module module;
-        try
+    public:
+        InterruptibleGumbelSearch(GumbelSearch &search, Node *root_node, float reflexion_time, const std::atomic<bool> &stop, const ProgressCallback &progress)
+            : search_(search),
+              root_node_(root_node),
+              reflexion_time_(reflexion_time),
+              stop_(stop),
+              progress_(progress),
+              nb_launched_simulations_(0),
+              start_time_(std::chrono::steady_clock::now()) {}
+
+        Node *next_leaf() override
         {
-            module = torch::jit::load(model_path);
+            // The root is evaluated before the search can be interrupted.
+            if (nb_launched_simulations_ > 0)
+            {
+                bool time_is_over = reflexion_time_ >= 0.0 && std::chrono::duration<float>(std::chrono::steady_clock::now() - start_time_).count() >= reflexion_time_;
+                if (stop_ || time_is_over)
+                {
+                    search_.interrupt();
+                }
+            }
+
+            Node *leaf = search_.next_leaf();
+            if (leaf != nullptr)
+            {
+                nb_launched_simulations_++;
+                if (progress_ && nb_launched_simulations_ % PROGRESS_INTERVAL == 0 && root_node_->is_expanded)
+                {
+                    progress_(game::move_to_python_format(root_node_->state, search_.selected_child()->move));
+                }
+            }
+            return leaf;
         }
-        catch (const c10::Error &e)
+
+        void complete(Node *leaf, const Evaluation &evaluation) override
         {
-            std::cerr << "Error loading the model\n";
-            throw e;
+            search_.complete(leaf, evaluation);
+        }
+
+        bool is_finished() const override
+        {
+            return search_.is_finished();
         }
 
-        std::vector<torch::Tensor> game_state_recoder;
-        std::vector<torch::Tensor> game_policy_recorder;
+    private:
+        GumbelSearch &search_;
+        Node *root_node_;
+        float reflexion_time_;
+        const std::atomic<bool> &stop_;
+        const ProgressCallback &progress_;
 
-        Node *root_node = new Node(state);
+        // Number of simulations started, and time at which the search started.
+        int nb_launched_simulations_;
+        std::chrono::steady_clock::time_point start_time_;
+    };
 
-        for (int _l = 0 ; _l < nb_simulations ; _l++)
+    std::pair<int, int> iris_zero_gumbel_search_int(
+        const game::GameState &state,
+        int nb_simulations,
+        float reflexion_time,
+        const std::string &model_path,
+        const std::atomic<bool> &stop,
+        const ProgressCallback &progress)
+    {
+        if (!game::exists_move(state))
         {
-            Node *selected_node = select(root_node);
-            expand(selected_node, module);
-            backpropagate(selected_node, selected_node->value);
+            return std::make_pair(-1, -1);
         }
 
-        auto best_move = next_move_best(root_node);
+        InferenceServer server(load_model(model_path), MAX_EVALUATIONS_IN_FLIGHT, std::chrono::microseconds(INFERENCE_MAX_WAIT_MICROSECONDS), INFERENCE_CACHE_SIZE);
+        std::mt19937 gen(0);
+
+        Node *root_node = new Node(state);
+
+        // The search is deterministic, see 'iris_zero_bot_gumbel_int'.
+        GumbelSearch search(root_node, nb_simulations, MAX_EVALUATIONS_IN_FLIGHT, gen, false);
+        InterruptibleGumbelSearch interruptible_search(search, root_node, reflexion_time, stop, progress);
+
+        SimulationScheduler scheduler(server, MAX_EVALUATIONS_IN_FLIGHT);
+        scheduler.add(&interruptible_search);
+        scheduler.run_until_finished();
 
-        auto result = move_to_python_format(root_node->state, best_move.second->state);
+        auto result = game::move_to_python_format(root_node->state, search.selected_child()->move);
 
         delete root_node;
 
         return result;
     }
 
-    std::tuple<torch::Tensor, torch::Tensor, torch::Tensor> generate_training_sample(
+    std::pair<int, int> iris_zero_bot_time(
         bool yellow_is_playing,
         int yellow_position,
         int red_position,
@@ -451,6 +572,7 @@ namespace iris_zero
         int black_consecutive_last_use,
         int white_consecutive_last_use,
         int orange_consecutive_last_use,
+        float reflexion_time,
         const std::string &model_path)
     {
         // Create a game state structure instance with the given parameters.
@@ -473,10 +595,10 @@ namespace iris_zero
             orange_consecutive_last_use
         };
         // Return the internal function result.
-        return generate_training_sample_int(state, model_path);
+        return iris_zero_bot_time_int(state, reflexion_time, model_path);
     }
 
-    std::pair<int, int> iris_zero_bot_time(
+    std::pair<int, int> iris_zero_bot_sim(
         bool yellow_is_playing,
         int yellow_position,
         int red_position,
@@ -493,7 +615,7 @@ namespace iris_zero
         int black_consecutive_last_use,
         int white_consecutive_last_use,
         int orange_consecutive_last_use,
-        float reflexion_time,
+        int nb_simulations,
         const std::string &model_path)
     {
         // Create a game state structure instance with the given parameters.
@@ -516,10 +638,10 @@ namespace iris_zero
             orange_consecutive_last_use
         };
         // Return the internal function result.
-        return iris_zero_bot_time_int(state, reflexion_time, model_path);
+        return iris_zero_bot_sim_int(state, nb_simulations, model_path);
     }
 
-    std::pair<int, int> iris_zero_bot_sim(
+    std::pair<int, int> iris_zero_bot_gumbel(
         bool yellow_is_playing,
         int yellow_position,
         int red_position,
@@ -559,6 +681,6 @@ namespace iris_zero
             orange_consecutive_last_use
         };
         // Return the internal function result.
-        return iris_zero_bot_sim_int(state, nb_simulations, model_path);
+        return iris_zero_bot_gumbel_int(state, nb_simulations, model_path);
     }
 }
\ No newline at end of file
@@ -0,0 +1,708 @@
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <random>
+#include <memory>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <torch/torch.h>
+#include <torch/script.h>
+#include "utils.hpp"
+#include "game/rules.hpp"
+#include "game/solver.hpp"
+#include "game/initial_board.hpp"
+#include "iris_zero/iris_zero_training.hpp"
+#include "iris_zero/iris_zero_search.hpp"
+#include "iris_zero/gumbel_search.hpp"
+#include "iris_zero/sample_shard.hpp"
+#include "iris_zero/simulation_scheduler.hpp"
+#include "iris_zero/iris_zero_constants.hpp"
+
+// Implementation of the training routines of 'iris_zero', see 'include/iris_zero/iris_zero_training.hpp'.
+namespace iris_zero
+{
+
+    // A self-played game, advanced one simulation at a time by a SimulationScheduler: the game gives the next leaf
+    // to evaluate, and is given back the model evaluation of that leaf. Several simulations of the game can wait for
+    // their evaluation at the same time, and the leaves of many games are evaluated together.
+    // The moves are searched either with PUCT and dirichlet noise at the root, or with the Gumbel root search
+    // (see 'include/iris_zero/gumbel_search.hpp'), which needs far fewer simulations per move.
+    // The PUCT searches use playout-cap randomization: only a fraction of the moves get a full search, whose result is
+    // recorded as a training target, the other moves get a cheap search and are not recorded. A search also stops
+    // early when the visit distribution of the root has stabilized.
+    // A game ends early when a player resigns, its root value having been beyond 'RESIGNATION_THRESHOLD' for
+    // 'RESIGNATION_CONSECUTIVE_MOVES' moves, or when the solver proves the outcome. A fraction of the games never
+    // resign, to measure how often a resignation would have been wrong.
+    // The game is played with the constants defined in 'constants.cpp'.
+    class SelfPlayGame : public SearchTask
+    {
+    public:
+        // Constructor taking the initial position, the seed of the random generator, the maximum number of suspended
+        // simulations, whether the moves are searched with the Gumbel root search, and an optional flag interrupting
+        // the game when set.
+        SelfPlayGame(
+            const game::GameState &state,
+            unsigned int seed,
+            int max_in_flight,
+            bool use_gumbel_search = false,
+            const std::atomic<bool> *stop = nullptr) : root_node_(new Node(state)),
+                                                        turn_(0),
+                                                        noise_added_(false),
+                                                        is_finished_(false),
+                                                        winner_(0.0),
+                                                        nb_pending_simulations_(0),
+                                                        max_in_flight_(std::max(1, max_in_flight)),
+                                                        is_full_search_(true),
+                                                        nb_move_simulations_(NUM_SIM_PER_MOVE),
+                                                        search_has_converged_(false),
+                                                        next_convergence_check_(0),
+                                                        previous_visits_(),
+                                                        is_resignation_exempt_(false),
+                                                        resignation_winner_(0.0),
+                                                        nb_resignation_moves_(0),
+                                                        predicted_winner_(0.0),
+                                                        use_gumbel_search_(use_gumbel_search),
+                                                        gumbel_search_(),
+                                                        stop_(stop),
+                                                        gen_(seed)
+        {
+            std::uniform_real_distribution<float> uniform_dist(0.0, 1.0);
+            is_resignation_exempt_ = uniform_dist(gen_) < RESIGNATION_EXEMPT_FRACTION;
+
+            if (MAX_NB_TURN_SAMPLE <= 0 || game::exists_winner(root_node_->state))
+            {
+                finish();
+            }
+            else
+            {
+                adjudicate();
+            }
+            start_move_search();
+        }
+
+        ~SelfPlayGame()
+        {
+            delete root_node_;
+        }
+
+        Node *next_leaf() override
+        {
+            while (!is_finished_ && !is_interrupted() && nb_pending_simulations_ < max_in_flight_)
+            {
+                // The Gumbel search of the move runs the simulations, and the move is played once it is finished.
+                if (use_gumbel_search_)
+                {
+                    if (!gumbel_search_)
+                    {
+                        gumbel_search_ = std::make_unique<GumbelSearch>(root_node_, GUMBEL_NUM_SIM_PER_MOVE, max_in_flight_, gen_);
+                    }
+
+                    Node *leaf = gumbel_search_->next_leaf();
+                    if (leaf != nullptr)
+                    {
+                        nb_pending_simulations_++;
+                        return leaf;
+                    }
+                    if (!gumbel_search_->is_finished())
+                    {
+                        return nullptr;
+                    }
+                    play_move();
+                    continue;
+                }
+
+                // The root is evaluated first, before the dirichlet noise can be added to its policy.
+                if (!root_node_->is_expanded)
+                {
+                    if (root_node_->evaluation_pending)
+                    {
+                        return nullptr;
+                    }
+                    return launch_simulation(root_node_);
+                }
+
+                // Only the full searches explore with dirichlet noise.
+                if (!noise_added_ && is_full_search_)
+                {
+                    add_dirichlet_noise(root_node_, gen_);
+                    noise_added_ = true;
+                }
+
+                // The move is played once all the simulations of the root are completed, or once the search has converged.
+                check_convergence();
+                if (root_node_->visits + nb_pending_simulations_ >= nb_move_simulations_ || search_has_converged_)
+                {
+                    if (nb_pending_simulations_ > 0)
+                    {
+                        return nullptr;
+                    }
+                    play_move();
+                    continue;
+                }
+
+                Node *selected_node = select(root_node_);
+
+                // Already expanded terminal nodes are backpropagated with their stored value.
+                if (selected_node->is_expanded)
+                {
+                    backpropagate(selected_node, selected_node->value);
+                    continue;
+                }
+
+                // The selection reached a leaf already waiting for its evaluation: wait for the suspended simulations.
+                if (selected_node->evaluation_pending)
+                {
+                    return nullptr;
+                }
+
+                return launch_simulation(selected_node);
+            }
+            return nullptr;
+        }
+
+        void complete(Node *leaf, const Evaluation &evaluation) override
+        {
+            if (gumbel_search_)
+            {
+                gumbel_search_->complete(leaf, evaluation);
+            }
+            else
+            {
+                complete_evaluation(leaf, evaluation);
+            }
+            nb_pending_simulations_--;
+        }
+
+        bool is_finished() const override
+        {
+            return is_finished_ || (is_interrupted() && nb_pending_simulations_ == 0);
+        }
+
+        // Returns true if the game was interrupted before its end.
+        bool is_interrupted() const
+        {
+            return stop_ != nullptr && stop_->load();
+        }
+
+        // Number of positions recorded so far.
+        int nb_positions() const
+        {
+            return game_state_recoder_.size();
+        }
+
+        // Result of the game: 1 for a yellow victory, -1 for a red victory, 0 for a draw.
+        float winner() const
+        {
+            return winner_;
+        }
+
+        // Returns the winner the game would have been resigned in favour of (0 if it would not have been resigned),
+        // if the game is exempted from resignation.
+        float resignation_prediction() const
+        {
+            return (is_resignation_exempt_) ? predicted_winner_ : 0.0;
+        }
+
+        // Returns the training sample of the finished game: (position tensor, policy tensor, value tensor).
+        TrainingSample training_sample() const
+        {
+            int nb_recorded_positions = game_state_recoder_.size();
+            if (nb_recorded_positions == 0)
+            {
+                return std::make_tuple(torch::empty({0, game::NUMBER_REAL_NODES, NUMBER_ATRIBUTES}), torch::empty({0, game::MAX_MVTS}), torch::empty({0}));
+            }
+
+            torch::Tensor stacked_positions = torch::stack(game_state_recoder_, 0);
+            torch::Tensor stacked_policies = torch::stack(game_policy_recorder_, 0);
+            torch::Tensor stacked_values = torch::full({nb_recorded_positions}, winner_);
+
+            return std::make_tuple(stacked_positions, stacked_policies, stacked_values);
+        }
+
+        // Appends the recorded positions of the finished game to a shard.
+        void write_to_shard(ShardWriter &writer) const
+        {
+            for (std::size_t k = 0; k < recorded_states_.size(); k++)
+            {
+                writer.write(recorded_states_[k], game_policy_recorder_[k].data_ptr<float>(), winner_);
+            }
+        }
+
+    private:
+        // Marks the leaf as waiting for its evaluation and returns it.
+        Node *launch_simulation(Node *leaf)
+        {
+            begin_evaluation(leaf);
+            nb_pending_simulations_++;
+            return leaf;
+        }
+
+        // Chooses the size of the PUCT search of the current move: a full search with probability
+        // 'PLAYOUT_CAP_FULL_SEARCH_PROBABILITY', a cheap one otherwise.
+        void start_move_search()
+        {
+            std::uniform_real_distribution<float> uniform_dist(0.0, 1.0);
+            is_full_search_ = use_gumbel_search_ || uniform_dist(gen_) < PLAYOUT_CAP_FULL_SEARCH_PROBABILITY;
+            nb_move_simulations_ = (is_full_search_) ? NUM_SIM_PER_MOVE : NUM_FAST_SIM_PER_MOVE;
+
+            noise_added_ = false;
+            search_has_converged_ = false;
+            next_convergence_check_ = root_node_->visits + EARLY_STOP_CHECK_INTERVAL;
+            previous_visits_.clear();
+        }
+
+        // Marks the search as converged if the visit distribution of the root children has changed by less than
+        // 'EARLY_STOP_KL_THRESHOLD' (Kullback-Leibler divergence) over the last 'EARLY_STOP_CHECK_INTERVAL' simulations.
+        // The distribution is compared every 'EARLY_STOP_CHECK_INTERVAL' completed simulations.
+        void check_convergence()
+        {
+            if (EARLY_STOP_KL_THRESHOLD <= 0.0 || search_has_converged_ || root_node_->visits < next_convergence_check_)
+            {
+                return;
+            }
+            next_convergence_check_ = root_node_->visits + EARLY_STOP_CHECK_INTERVAL;
+
+            int nb_children = root_node_->children.size();
+            std::vector<int> visits(nb_children);
+            int sum_visits = 0, sum_previous_visits = 0;
+            for (int i = 0; i < nb_children; i++)
+            {
+                visits[i] = root_node_->children[i]->visits;
+                sum_visits += visits[i];
+            }
+
+            if (!previous_visits_.empty())
+            {
+                for (int previous : previous_visits_)
+                {
+                    sum_previous_visits += previous;
+                }
+
+                // KL divergence from the current distribution to the previous one, the previous visits being smoothed
+                // so that the moves visited for the first time keep the divergence finite.
+                float kl = 0.0;
+                for (int i = 0; i < nb_children; i++)
+                {
+                    if (visits[i] > 0)
+                    {
+                        float p = static_cast<float>(visits[i]) / sum_visits;
+                        float q = (previous_visits_[i] + 0.5f) / (sum_previous_visits + 0.5f * nb_children);
+                        kl += p * std::log(p / q);
+                    }
+                }
+                search_has_converged_ = sum_visits > 0 && kl < EARLY_STOP_KL_THRESHOLD;
+            }
+
+            previous_visits_ = visits;
+        }
+
+        // Records the root position with its search policy if the search is a full one, and plays the next move.
+        // With the Gumbel search, the recorded policy is the improved policy, and the move is the one chosen by the search.
+        void play_move()
+        {
+            torch::Tensor root_policy = (gumbel_search_) ? gumbel_search_->improved_policy() : node_mcts_policy(root_node_);
+
+            if (is_full_search_)
+            {
+                game_state_recoder_.push_back(torch::from_blob(root_node_->planes.data(), {game::NUMBER_REAL_NODES, NUMBER_ATRIBUTES}).clone());
+                game_policy_recorder_.push_back(root_policy);
+                recorded_states_.push_back(root_node_->state);
+            }
+
+            if (should_resign())
+            {
+                winner_ = resignation_winner_;
+                is_finished_ = true;
+                return;
+            }
+
+            Node *new_root;
+            int idx_new_root;
+
+            if (gumbel_search_)
+            {
+                new_root = gumbel_search_->selected_child();
+                idx_new_root = std::find(root_node_->children.begin(), root_node_->children.end(), new_root) - root_node_->children.begin();
+                gumbel_search_.reset();
+            }
+            else if (turn_ <= NUM_TURN_EXP_BEFORE_BEST)
+            {
+                auto res = next_move_best_exp(root_node_, root_policy, gen_);
+                idx_new_root = res.first;
+                new_root = res.second;
+            }
+            else
+            {
+                auto res = next_move_best(root_node_);
+                idx_new_root = res.first;
+                new_root = res.second;
+            }
+
+            root_node_->children[idx_new_root] = nullptr;
+            new_root->parent = nullptr;
+            delete root_node_;
+            root_node_ = new_root;
+
+            start_move_search();
+            ++turn_;
+
+            if (turn_ >= MAX_NB_TURN_SAMPLE || game::exists_winner(root_node_->state))
+            {
+                finish();
+            }
+            else
+            {
+                adjudicate();
+            }
+        }
+
+        // Updates the resignation count with the value of the searched root, and returns true if the player losing
+        // according to the search has to resign. The games exempted from resignation record the predicted winner instead.
+        bool should_resign()
+        {
+            if (RESIGNATION_THRESHOLD >= 1.0 || root_node_->visits == 0)
+            {
+                return false;
+            }
+
+            // The Q-value of the root is given for the player who moved to it, and converted for yellow.
+            float root_value = root_node_->wins / root_node_->visits;
+            float yellow_value = (root_node_->state.yellow_is_playing) ? -root_value : root_value;
+
+            float winner = 0.0;
+            if (yellow_value > RESIGNATION_THRESHOLD)
+            {
+                winner = 1.0;
+            }
+            else if (yellow_value < -RESIGNATION_THRESHOLD)
+            {
+                winner = -1.0;
+            }
+
+            if (winner == 0.0)
+            {
+                nb_resignation_moves_ = 0;
+            }
+            else if (winner == resignation_winner_)
+            {
+                nb_resignation_moves_++;
+            }
+            else
+            {
+                nb_resignation_moves_ = 1;
+            }
+            resignation_winner_ = winner;
+
+            if (nb_resignation_moves_ < RESIGNATION_CONSECUTIVE_MOVES)
+            {
+                return false;
+            }
+            if (is_resignation_exempt_)
+            {
+                if (predicted_winner_ == 0.0)
+                {
+                    predicted_winner_ = winner;
+                }
+                return false;
+            }
+            return true;
+        }
+
+        // Ends the game if the solver proves its outcome within 'ADJUDICATION_SOLVER_DEPTH' plies.
+        void adjudicate()
+        {
+            int result = game::solve(root_node_->state, ADJUDICATION_SOLVER_DEPTH);
+            if (result != 0)
+            {
+                winner_ = result;
+                is_finished_ = true;
+            }
+        }
+
+        // Records the final position if the game has a winner, and sets the game result.
+        void finish()
+        {
+            if (turn_ < MAX_NB_TURN_SAMPLE && game::exists_winner(root_node_->state))
+            {
+                torch::Tensor win_policy = torch::ones({game::MAX_MVTS});
+                win_policy = win_policy / game::MAX_MVTS;
+
+                game_state_recoder_.push_back(game_state_to_tensor(root_node_->state));
+                game_policy_recorder_.push_back(win_policy);
+                recorded_states_.push_back(root_node_->state);
+
+                if (root_node_->state.yellow_is_playing)
+                {
+                    winner_ = -1.0;
+                }
+                else
+                {
+                    winner_ = 1.0;
+                }
+                turn_++;
+            }
+            is_finished_ = true;
+        }
+
+        // Root of the search tree, representing the current position of the game.
+        Node *root_node_;
+
+        // Number of turns played (plus one for the final position when there is a winner).
+        int turn_;
+
+        // Flag indicating whether the dirichlet noise has been added to the current root.
+        bool noise_added_;
+
+        // Flag indicating whether the game is over.
+        bool is_finished_;
+
+        // Result of the game: 1 for a yellow victory, -1 for a red victory, 0 for a draw.
+        float winner_;
+
+        // Number of simulations waiting for their evaluation, and its maximum.
+        int nb_pending_simulations_;
+        int max_in_flight_;
+
+        // Flag indicating whether the search of the current move is a full one, recorded as a training target,
+        // and the number of root visits at which the search stops.
+        bool is_full_search_;
+        int nb_move_simulations_;
+
+        // Flag indicating whether the search of the current move has converged, the number of root visits at which the
+        // convergence is checked next, and the visits of the root children at the previous check (empty before the first one).
+        bool search_has_converged_;
+        int next_convergence_check_;
+        std::vector<int> previous_visits_;
+
+        // Flag indicating whether the game is exempted from resignation, the player judged winning by the last search
+        // (0 if none) and the number of consecutive moves it has been, and the winner the game would have been resigned
+        // in favour of if it is exempted (0 if none).
+        bool is_resignation_exempt_;
+        float resignation_winner_;
+        int nb_resignation_moves_;
+        float predicted_winner_;
+
+        // Flag indicating whether the moves are searched with the Gumbel root search, and the search of the current move.
+        bool use_gumbel_search_;
+        std::unique_ptr<GumbelSearch> gumbel_search_;
+
+        // Flag interrupting the game, if any.
+        const std::atomic<bool> *stop_;
+
+        // Random generator used for the dirichlet or Gumbel noise and the move selection.
+        std::mt19937 gen_;
+
+        // Recorded positions and search policies, and the game states of the recorded positions.
+        std::vector<torch::Tensor> game_state_recoder_;
+        std::vector<torch::Tensor> game_policy_recorder_;
+        std::vector<game::GameState> recorded_states_;
+    };
+
+    // This internal function takes as input an initial gamestate, a model, and generates a training sample from it.
+    // A training sample is a tuple of (posion tensor, policy tensor, value tensor) from a self-played game with the constants defined in 'constants.cpp'.
+    std::tuple<torch::Tensor, torch::Tensor, torch::Tensor> generate_training_sample_int(const game::GameState &state, const std::string &model_path)
+    {
+        std::random_device rd;
+
+        Model model = load_model(model_path);
+
+        SelfPlayGame self_play_game(state, rd(), MAX_EVALUATIONS_IN_FLIGHT);
+
+        // The leaves are evaluated one at a time, each simulation is completed before the next one starts.
+        // The game returns no leaf once it is finished.
+        while (Node *leaf = self_play_game.next_leaf())
+        {
+            torch::Tensor state_tensor = torch::from_blob(leaf->planes.data(), {game::NUMBER_REAL_NODES, NUMBER_ATRIBUTES});
+            self_play_game.complete(leaf, position_evaluation(state_tensor, model));
+        }
+
+        return self_play_game.training_sample();
+    }
+
+    std::tuple<torch::Tensor, torch::Tensor, torch::Tensor> generate_training_sample(
+        bool yellow_is_playing,
+        int yellow_position,
+        int red_position,
+        int black_position,
+        int white_position,
+        int orange_position,
+        int yellow_colors,
+        int red_colors,
+        int black_colors,
+        int white_colors,
+        bool black_last_use,
+        bool white_last_use,
+        bool orange_last_use,
+        int black_consecutive_last_use,
+        int white_consecutive_last_use,
+        int orange_consecutive_last_use,
+        const std::string &model_path)
+    {
+        // Create a game state structure instance with the given parameters.
+        game::GameState state = {
+            yellow_is_playing,
+            yellow_position,
+            red_position,
+            black_position,
+            white_position,
+            orange_position,
+            yellow_colors,
+            red_colors,
+            black_colors,
+            white_colors,
+            black_last_use,
+            white_last_use,
+            orange_last_use,
+            black_consecutive_last_use,
+            white_consecutive_last_use,
+            orange_consecutive_last_use
+        };
+        // Return the internal function result.
+        return generate_training_sample_int(state, model_path);
+    }
+
+    SelfPlayEngine::SelfPlayEngine(
+        const game::GameState &initial_state,
+        int nb_games,
+        const std::string &model_path,
+        int nb_threads,
+        int batch_size,
+        bool use_gumbel_search,
+        const std::string &shard_path,
+        bool random_initial_boards) : inference_server_(load_model(model_path), batch_size, std::chrono::microseconds(INFERENCE_MAX_WAIT_MICROSECONDS), INFERENCE_CACHE_SIZE),
+                          initial_state_(initial_state),
+                          nb_games_(nb_games),
+                          use_gumbel_search_(use_gumbel_search),
+                          random_initial_boards_(random_initial_boards),
+                          shard_writer_((shard_path.empty()) ? nullptr : std::make_unique<ShardWriter>(shard_path)),
+                          nb_games_per_thread_(std::max(1, (batch_size + std::max(1, nb_threads) - 1) / std::max(1, nb_threads))),
+                          nb_started_games_(0),
+                          nb_positions_(0),
+                          stop_(false),
+                          start_time_(std::chrono::steady_clock::now()),
+                          finished_samples_(),
+                          nb_finished_games_(0),
+                          nb_running_threads_(std::max(1, nb_threads)),
+                          nb_resignation_checks_(0),
+                          nb_false_resignations_(0)
+    {
+        // Start the worker threads.
+        for (int k = 0; k < nb_running_threads_; k++)
+        {
+            workers_.emplace_back(&SelfPlayEngine::worker_loop, this);
+        }
+    }
+
+    SelfPlayEngine::~SelfPlayEngine()
+    {
+        stop_ = true;
+        for (std::thread &worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+    void SelfPlayEngine::worker_loop()
+    {
+        std::random_device rd;
+
+        // Start new games to keep 'nb_games_per_thread_' of them running.
+        auto start_game = [this, &rd]() -> std::unique_ptr<SelfPlayGame>
+        {
+            if (nb_started_games_ >= nb_games_ || nb_started_games_.fetch_add(1) >= nb_games_)
+            {
+                return nullptr;
+            }
+            game::GameState initial_state = (random_initial_boards_) ? game::random_initial_state(rd()) : initial_state_;
+            return std::make_unique<SelfPlayGame>(initial_state, rd(), BATCH_SEARCH_EVALUATIONS_IN_FLIGHT, use_gumbel_search_, &stop_);
+        };
+
+        // Publish a finished game.
+        auto finish_game = [this](SelfPlayGame &self_play_game)
+        {
+            nb_positions_ += self_play_game.nb_positions();
+            float resignation_prediction = self_play_game.resignation_prediction();
+
+            // The game is either appended to the shard, or queued for 'next_sample'.
+            if (shard_writer_)
+            {
+                std::lock_guard<std::mutex> lock(shard_mutex_);
+                self_play_game.write_to_shard(*shard_writer_);
+                shard_writer_->flush();
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(samples_mutex_);
+                if (!shard_writer_)
+                {
+                    finished_samples_.push_back(self_play_game.training_sample());
+                }
+                nb_finished_games_++;
+
+                // An exempted game that would have been resigned checks the resignation.
+                if (resignation_prediction != 0.0)
+                {
+                    nb_resignation_checks_++;
+                    nb_false_resignations_ += (resignation_prediction != self_play_game.winner());
+                }
+            }
+            samples_condition_.notify_all();
+        };
+
+        // The simulations of the games of this thread are interleaved by the scheduler: while some leaves are
+        // evaluated, the searches keep selecting other ones.
+        run_searches<SelfPlayGame>(inference_server_, nb_games_per_thread_, BATCH_SEARCH_EVALUATIONS_IN_FLIGHT, start_game, finish_game, &stop_);
+
+        {
+            std::lock_guard<std::mutex> lock(samples_mutex_);
+            nb_running_threads_--;
+        }
+        samples_condition_.notify_all();
+    }
+
+    std::optional<TrainingSample> SelfPlayEngine::next_sample()
+    {
+        std::unique_lock<std::mutex> lock(samples_mutex_);
+        samples_condition_.wait(lock, [this]
+                                { return !finished_samples_.empty() || nb_running_threads_ == 0; });
+
+        if (finished_samples_.empty())
+        {
+            return std::nullopt;
+        }
+
+        TrainingSample sample = finished_samples_.front();
+        finished_samples_.pop_front();
+        return sample;
+    }
+
+    float SelfPlayEngine::positions_per_second() const
+    {
+        float elapsed_time = std::chrono::duration<float>(std::chrono::steady_clock::now() - start_time_).count();
+        return (elapsed_time > 0.0) ? nb_positions_ / elapsed_time : 0.0;
+    }
+
+    float SelfPlayEngine::average_batch_size() const
+    {
+        return inference_server_.average_batch_size();
+    }
+
+    float SelfPlayEngine::cache_hit_rate() const
+    {
+        return inference_server_.cache_hit_rate();
+    }
+
+    int SelfPlayEngine::nb_finished_games() const
+    {
+        std::lock_guard<std::mutex> lock(samples_mutex_);
+        return nb_finished_games_;
+    }
+
+    float SelfPlayEngine::false_resignation_rate() const
+    {
+        std::lock_guard<std::mutex> lock(samples_mutex_);
+        return (nb_resignation_checks_ > 0) ? static_cast<float>(nb_false_resignations_) / nb_resignation_checks_ : 0.0;
+    }
+}
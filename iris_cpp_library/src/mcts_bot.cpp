@@ -3,12 +3,15 @@
 #include <cmath>
 #include <algorithm>
 #include <chrono>
+#include <atomic>
+#include <cstdint>
+#include <limits>
 #include "mcts/mcts_bot.hpp"
 #include "mcts/mcts_constants.hpp"
 #include "game/state.hpp"
 #include "game/move_iterator.hpp"
+#include "game/move.hpp"
 #include "game/rules.hpp"
-#include "utils.hpp"
 
 // Implementation of 'mcts_bot', see 'include/mcts/mcts_bot.hpp'.
 namespace mcts
@@ -21,6 +24,9 @@ namespace mcts
         // The game state that this node represents.
         game::GameState state;
 
+        // The move leading from the parent node to this node.
+        game::Move move;
+
         // Pointer to the parent node in the MCTS tree.
         Node *parent;
 
@@ -34,7 +40,7 @@ namespace mcts
         // Number of times this node has been visited.
         int visits;
 
-        Node(game::GameState state, Node *parent = nullptr) : state(state), parent(parent), children(), wins(0.0), visits(0) {}
+        Node(game::GameState state, game::Move move = game::Move(), Node *parent = nullptr) : state(state), move(move), parent(parent), children(), wins(0.0), visits(0) {}
     };
 
     // Recursively deletes a node and all of its descendants.
@@ -104,7 +110,7 @@ namespace mcts
             nb_observed_legal_move++;
             float random_number = dis(gen);
 
-            Node *new_node = new Node(move.second, node);
+            Node *new_node = new Node(move.second, game::Move(move.first), node);
             node->children.push_back(new_node);
 
             if (random_number * nb_observed_legal_move <= 1.0)
@@ -177,29 +183,13 @@ namespace mcts
         }
     }
 
-    // Internal function implementing the full MCTS algorithm with a time limit.
-    std::pair<int, int> mcts_bot_time_int(float reflexion_time, const game::GameState &root_state)
+    // Returns the most visited child of an expanded node.
+    Node *most_visited_child(Node *node)
     {
-        Node *root = new Node(root_state);
-
-        std::random_device rd;
-        std::mt19937 gen(rd());
-
-        std::uniform_real_distribution<> dis(0, 1);
-
-        auto start_time = std::chrono::high_resolution_clock::now();
-        while (std::chrono::duration_cast<std::chrono::seconds>(std::chrono::high_resolution_clock::now() - start_time).count() < reflexion_time)
-        {
-            Node *selected_node = select(root);
-            Node *expanded_node = expand(selected_node);
-            int result = simulate(expanded_node, gen, dis);
-            backpropagate(expanded_node, result);
-        }
-
         Node *best_child = nullptr;
         int max_visits = std::numeric_limits<int>::min();
 
-        for (Node *child : root->children)
+        for (Node *child : node->children)
         {
             if (child->visits > max_visits)
             {
@@ -207,16 +197,16 @@ namespace mcts
                 best_child = child;
             }
         }
-
-        std::pair<int, int> result = move_to_python_format(root_state, best_child->state);
-        delete_node(root);
-
-        return result;
+        return best_child;
     }
 
-    // Internal function implementing the full MCTS algorithm with a maximum number of simulations.
-    std::pair<int, int> mcts_bot_sim_int(int nb_simulations, const game::GameState &root_state)
+    std::pair<int, int> mcts_search_int(const game::GameState &root_state, int nb_simulations, float reflexion_time, const std::atomic<bool> &stop, const ProgressCallback &progress)
     {
+        if (!game::exists_move(root_state))
+        {
+            return std::make_pair(-1, -1);
+        }
+
         Node *root = new Node(root_state);
 
         std::random_device rd;
@@ -224,32 +214,46 @@ namespace mcts
 
         std::uniform_real_distribution<> dis(0, 1);
 
-        for (int _l = 0; _l < nb_simulations; _l++)
+        // The first simulation always runs, so that the root is expanded.
+        auto start_time = std::chrono::steady_clock::now();
+        for (int simulation = 0; simulation < nb_simulations; simulation++)
         {
+            if (simulation > 0 && (stop || (reflexion_time >= 0.0 && std::chrono::duration<float>(std::chrono::steady_clock::now() - start_time).count() >= reflexion_time)))
+            {
+                break;
+            }
+
             Node *selected_node = select(root);
             Node *expanded_node = expand(selected_node);
             int result = simulate(expanded_node, gen, dis);
             backpropagate(expanded_node, result);
-        }
-
-        Node *best_child = nullptr;
-        int max_visits = std::numeric_limits<int>::min();
 
-        for (Node *child : root->children)
-        {
-            if (child->visits > max_visits)
+            if (progress && (simulation + 1) % PROGRESS_INTERVAL == 0)
             {
-                max_visits = child->visits;
-                best_child = child;
+                progress(game::move_to_python_format(root_state, most_visited_child(root)->move));
             }
         }
 
-        std::pair<int, int> result = move_to_python_format(root_state, best_child->state);
+        std::pair<int, int> result = game::move_to_python_format(root_state, most_visited_child(root)->move);
         delete_node(root);
 
         return result;
     }
 
+    // Internal function implementing the full MCTS algorithm with a time limit.
+    std::pair<int, int> mcts_bot_time_int(float reflexion_time, const game::GameState &root_state)
+    {
+        std::atomic<bool> stop(false);
+        return mcts_search_int(root_state, std::numeric_limits<int>::max(), reflexion_time, stop, nullptr);
+    }
+
+    // Internal function implementing the full MCTS algorithm with a maximum number of simulations.
+    std::pair<int, int> mcts_bot_sim_int(int nb_simulations, const game::GameState &root_state)
+    {
+        std::atomic<bool> stop(false);
+        return mcts_search_int(root_state, nb_simulations, -1.0, stop, nullptr);
+    }
+
     std::pair<int, int> mcts_bot_time(bool yellow_is_playing,
                                       int yellow_position,
                                       int red_position,
@@ -2,9 +2,9 @@
 #include <algorithm>
 #include "minmax_bot/minmax_bot.hpp"
 #include "game/state.hpp"
+#include "game/move.hpp"
 #include "game/move_iterator.hpp"
 #include "game/rules.hpp"
-#include "utils.hpp"
 
 // Implementation of 'minmax_bot', see 'include/minmax_bot/minmax_bot.hpp'.
 namespace minmax_bot
@@ -83,8 +83,8 @@ namespace minmax_bot
         // Distribution for decision making, generates number between 0 and 1.
         std::uniform_real_distribution<> dis(0, 1);
 
-        // Placeholder for the potential next game state.
-        game::GameState child;
+        // Placeholder for the best move.
+        game::Move best_move;
 
         // Counter for the number of highest value moves seen so far.
         int nb_observed_best_move = 0;
@@ -108,7 +108,7 @@ namespace minmax_bot
                     // Update variables.
                     best_value_so_far = current_value;
                     nb_observed_best_move = 1;
-                    child = move.second;
+                    best_move = game::Move(move.first);
 
                     // Alpha-Beta pruning.
                     if (current_value > beta)
@@ -124,7 +124,7 @@ namespace minmax_bot
 
                     // Uniform on the fly selection of the child from best value moves.
                     if (random_number * nb_observed_best_move <= 1.0)
-                        child = move.second;
+                        best_move = game::Move(move.first);
                     
                     // Alpha-Beta pruning.
                     if (current_value > beta)
@@ -146,7 +146,7 @@ namespace minmax_bot
                 {
                     best_value_so_far = current_value;
                     nb_observed_best_move = 1;
-                    child = move.second;
+                    best_move = game::Move(move.first);
 
                     if (current_value < alpha)
                         break;
@@ -158,14 +158,14 @@ namespace minmax_bot
                     float random_number = dis(gen);
 
                     if (random_number * nb_observed_best_move <= 1.0)
-                        child = move.second;
+                        best_move = game::Move(move.first);
                     if (current_value < alpha)
                         break;
                     beta = std::min(beta, current_value);
                 }
             }
         }
-        return move_to_python_format(state, child);
+        return game::move_to_python_format(state, best_move);
     }
 
     std::pair<int, int> minmax_bot(bool yellow_is_playing,
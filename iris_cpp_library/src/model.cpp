@@ -0,0 +1,67 @@
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <torch/torch.h>
+#include <torch/script.h>
+#include "iris_zero/model.hpp"
+#include "iris_zero/native_network.hpp"
+
+// Implementation of the 'Model' class, see 'include/iris_zero/model.hpp'.
+namespace iris_zero
+{
+    Model::Model(torch::jit::script::Module module) : module_(module),
+                                                      network_() {}
+
+    Model::Model(std::shared_ptr<const NativeNetwork> network) : module_(),
+                                                                 network_(network) {}
+
+    std::pair<torch::Tensor, torch::Tensor> Model::evaluate(const torch::Tensor &states_tensor)
+    {
+        if (!network_)
+        {
+            std::vector<torch::jit::IValue> inputs = {states_tensor};
+
+            torch::NoGradGuard no_grad;
+            auto output_tuple = module_.forward(inputs).toTuple();
+
+            torch::Tensor policy_logits = output_tuple->elements()[0].toTensor();
+            torch::Tensor values = output_tuple->elements()[1].toTensor();
+            return std::make_pair(policy_logits, values);
+        }
+
+        // The native engine reads the positions and writes its outputs directly in the tensors' memory.
+        torch::Tensor input = states_tensor.contiguous();
+        int batch_size = input.size(0);
+        int action_size = network_->action_size();
+
+        torch::Tensor policy_logits = torch::empty({batch_size, action_size});
+        torch::Tensor values = torch::empty({batch_size, 1});
+
+        network_->forward(input.data_ptr<float>(), batch_size, policy_logits.data_ptr<float>(), values.data_ptr<float>());
+
+        return std::make_pair(policy_logits, values);
+    }
+
+    bool Model::is_native() const
+    {
+        return static_cast<bool>(network_);
+    }
+
+    std::pair<float, float> quantize_model(const std::string &model_path, const std::string &quantized_model_path, const torch::Tensor &positions)
+    {
+        if (!is_native_model_file(model_path))
+        {
+            throw std::runtime_error("Only the models exported for the native engine can be quantized: " + model_path);
+        }
+
+        NativeNetwork network(model_path);
+
+        torch::Tensor calibration_positions = positions.to(torch::kFloat32).contiguous();
+        QuantizationReport report = network.quantize(calibration_positions.data_ptr<float>(), calibration_positions.size(0));
+
+        network.save(quantized_model_path);
+        return std::make_pair(report.policy_kl, report.value_mse);
+    }
+}
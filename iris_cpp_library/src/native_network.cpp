@@ -0,0 +1,755 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define IRIS_ZERO_AVX2
+#endif
+#include "iris_zero/native_network.hpp"
+
+// Implementation of the 'NativeNetwork' class, see 'include/iris_zero/native_network.hpp'.
+//
+// Layout of the weight file (little-endian), as written by 'iris_python_code/model_utils/export/native_export.py':
+// the magic number "IRZN", the format version, then the int32 hyperparameters (number of nodes, input channels,
+// channels, residual blocks, moves, value head channels), and the float32 tensors in the order of the modules of
+// 'IrisZero': the normalized adjacency matrix, then for each graph convolution its linear layer (weight, bias) and
+// its BatchNorm (weight, bias, running mean, running variance, epsilon), and the linear layers of the heads.
+// The files written by 'NativeNetwork::save' (version 2) hold the same header and adjacency matrix, followed by the
+// layers of the forward pass as loaded: transposed weights with the BatchNorm folded, in fp32 or int8 with their scales.
+namespace iris_zero
+{
+    namespace
+    {
+        const char NATIVE_MODEL_MAGIC[4] = {'I', 'R', 'Z', 'N'};
+        const std::int32_t NATIVE_MODEL_VERSION = 1;
+        const std::int32_t SAVED_MODEL_VERSION = 2;
+
+        // Clipping ratios tried for the scales of each layer when calibrating the quantization.
+        const float QUANTIZATION_CLIP_RATIOS[] = {1.0, 0.8, 0.6};
+
+        // Sequential reader of a weight file, throwing on truncated files.
+        class WeightReader
+        {
+        public:
+            explicit WeightReader(const std::string &model_path) : file_(model_path, std::ios::binary), model_path_(model_path)
+            {
+                if (!file_)
+                {
+                    throw std::runtime_error("Cannot open the model file " + model_path);
+                }
+            }
+
+            void read_bytes(char *data, std::size_t size)
+            {
+                if (!file_.read(data, size))
+                {
+                    throw std::runtime_error("Truncated model file " + model_path_);
+                }
+            }
+
+            int read_int()
+            {
+                std::int32_t value;
+                read_bytes(reinterpret_cast<char *>(&value), sizeof(value));
+                return value;
+            }
+
+            std::vector<float> read_floats(int size)
+            {
+                std::vector<float> values(size);
+                read_bytes(reinterpret_cast<char *>(values.data()), sizeof(float) * size);
+                return values;
+            }
+
+            std::vector<std::int8_t> read_int8s(int size)
+            {
+                std::vector<std::int8_t> values(size);
+                read_bytes(reinterpret_cast<char *>(values.data()), size);
+                return values;
+            }
+
+        private:
+            std::ifstream file_;
+            std::string model_path_;
+        };
+
+        // Per-thread buffers of the forward pass, grown to the largest batch seen by the thread.
+        thread_local std::vector<float> workspace;
+
+        // output[o] = init[o] + sum_i input[i] * weights[i * output_size + o] (init may be null), for a block of
+        // 8 * B output channels starting at 'o', the accumulators being kept in registers.
+#ifdef IRIS_ZERO_AVX2
+        template <int B>
+        inline void dense_block(const float *input, int input_size, const float *weights, int output_size, int o, const float *init, float *output)
+        {
+            __m256 acc[B];
+            for (int j = 0; j < B; j++)
+            {
+                acc[j] = (init != nullptr) ? _mm256_loadu_ps(init + o + 8 * j) : _mm256_setzero_ps();
+            }
+            for (int i = 0; i < input_size; i++)
+            {
+                // The inputs are one-hot encodings or ReLU outputs: most of them are zero.
+                if (input[i] == 0.0f)
+                {
+                    continue;
+                }
+                __m256 x = _mm256_set1_ps(input[i]);
+                const float *row = weights + i * output_size + o;
+                for (int j = 0; j < B; j++)
+                {
+                    acc[j] = _mm256_fmadd_ps(x, _mm256_loadu_ps(row + 8 * j), acc[j]);
+                }
+            }
+            for (int j = 0; j < B; j++)
+            {
+                _mm256_storeu_ps(output + o + 8 * j, acc[j]);
+            }
+        }
+#endif
+
+        // Computes output = init + input * weights for a single row (init may be null), see 'dense_block'.
+        inline void dense_row(const float *input, int input_size, const float *weights, int output_size, const float *init, float *output)
+        {
+            int o = 0;
+#ifdef IRIS_ZERO_AVX2
+            for (; o + 32 <= output_size; o += 32)
+            {
+                dense_block<4>(input, input_size, weights, output_size, o, init, output);
+            }
+            for (; o + 8 <= output_size; o += 8)
+            {
+                dense_block<1>(input, input_size, weights, output_size, o, init, output);
+            }
+#endif
+            for (int k = o; k < output_size; k++)
+            {
+                output[k] = (init != nullptr) ? init[k] : 0.0f;
+            }
+            for (int i = 0; i < input_size; i++)
+            {
+                if (input[i] == 0.0f)
+                {
+                    continue;
+                }
+                const float *row = weights + i * output_size;
+                for (int k = o; k < output_size; k++)
+                {
+                    output[k] += input[i] * row[k];
+                }
+            }
+        }
+
+        // Largest quantized activation. The activations are quantized to 7 bits, so that the sum of two products
+        // of an activation and an int8 weight fits in an int16 (127 * 127 * 2 < 32767), see 'quantized_dense_block'.
+        const int MAX_QUANTIZED_ACTIVATION = 127;
+
+        // Per-thread buffer of the quantized activations of a row.
+        thread_local std::vector<std::uint8_t> quantized_input;
+
+        // Quantized linear layer on a row of quantized activations, for a block of 8 * B output channels starting
+        // at 'o': output[o] = init[o] + input_scale * scales[o] * sum_i input[i] * weights[i][o].
+        // The inputs are grouped by four, and the weights are packed as (group, output channel, 4), so that one
+        // 'maddubs' / 'madd' pair (a single 'dpbusd' with VNNI) computes four products for eight output channels in int32.
+#ifdef IRIS_ZERO_AVX2
+        template <int B>
+        inline void quantized_dense_block(const std::uint8_t *input, int nb_groups, const std::int8_t *weights, int output_size, int o, float input_scale, const float *scales, const float *init, float *output)
+        {
+            [[maybe_unused]] const __m256i ones = _mm256_set1_epi16(1);
+            __m256i acc[B];
+            for (int j = 0; j < B; j++)
+            {
+                acc[j] = _mm256_setzero_si256();
+            }
+            for (int g = 0; g < nb_groups; g++)
+            {
+                std::int32_t group;
+                std::memcpy(&group, input + 4 * g, sizeof(group));
+
+                // Most activations are zero (one-hot encodings and ReLU outputs).
+                if (group == 0)
+                {
+                    continue;
+                }
+                __m256i x = _mm256_set1_epi32(group);
+                const std::int8_t *packed = weights + (g * output_size + o) * 4;
+                for (int j = 0; j < B; j++)
+                {
+                    __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(packed + 32 * j));
+#if defined(__AVXVNNI__)
+                    acc[j] = _mm256_dpbusd_avx_epi32(acc[j], x, w);
+#elif defined(__AVX512VNNI__) && defined(__AVX512VL__)
+                    acc[j] = _mm256_dpbusd_epi32(acc[j], x, w);
+#else
+                    acc[j] = _mm256_add_epi32(acc[j], _mm256_madd_epi16(_mm256_maddubs_epi16(x, w), ones));
+#endif
+                }
+            }
+            __m256 vscale = _mm256_set1_ps(input_scale);
+            for (int j = 0; j < B; j++)
+            {
+                __m256 result = _mm256_mul_ps(_mm256_cvtepi32_ps(acc[j]), _mm256_mul_ps(vscale, _mm256_loadu_ps(scales + o + 8 * j)));
+                if (init != nullptr)
+                {
+                    result = _mm256_add_ps(result, _mm256_loadu_ps(init + o + 8 * j));
+                }
+                _mm256_storeu_ps(output + o + 8 * j, result);
+            }
+        }
+#endif
+
+        // Quantizes a row of non-negative activations, and computes the quantized linear layer on it,
+        // see 'quantized_dense_block'. The integer products are exact, so both code paths give the same result.
+        inline void quantized_dense_row(const float *input, int input_size, const std::int8_t *weights, int output_size, float input_scale, const float *scales, const float *init, float *output)
+        {
+            const int nb_groups = (input_size + 3) / 4;
+            if (static_cast<int>(quantized_input.size()) < 4 * nb_groups)
+            {
+                quantized_input.resize(4 * nb_groups);
+            }
+            std::uint8_t *activations = quantized_input.data();
+            const float inverse_scale = 1.0f / input_scale;
+            for (int i = 0; i < input_size; i++)
+            {
+                float quantized = std::round(input[i] * inverse_scale);
+                activations[i] = static_cast<std::uint8_t>(std::clamp(quantized, 0.0f, static_cast<float>(MAX_QUANTIZED_ACTIVATION)));
+            }
+            for (int i = input_size; i < 4 * nb_groups; i++)
+            {
+                activations[i] = 0;
+            }
+
+            int o = 0;
+#ifdef IRIS_ZERO_AVX2
+            for (; o + 32 <= output_size; o += 32)
+            {
+                quantized_dense_block<4>(activations, nb_groups, weights, output_size, o, input_scale, scales, init, output);
+            }
+            for (; o + 8 <= output_size; o += 8)
+            {
+                quantized_dense_block<1>(activations, nb_groups, weights, output_size, o, input_scale, scales, init, output);
+            }
+#endif
+            for (int k = o; k < output_size; k++)
+            {
+                std::int32_t acc = 0;
+                for (int g = 0; g < nb_groups; g++)
+                {
+                    const std::int8_t *packed = weights + (g * output_size + k) * 4;
+                    for (int j = 0; j < 4; j++)
+                    {
+                        acc += activations[4 * g + j] * packed[j];
+                    }
+                }
+                output[k] = acc * (input_scale * scales[k]) + ((init != nullptr) ? init[k] : 0.0f);
+            }
+        }
+
+        // y += a * x over 'size' floats.
+        inline void axpy(float a, const float *x, float *y, int size)
+        {
+            int k = 0;
+#ifdef IRIS_ZERO_AVX2
+            __m256 va = _mm256_set1_ps(a);
+            for (; k + 8 <= size; k += 8)
+            {
+                _mm256_storeu_ps(y + k, _mm256_fmadd_ps(va, _mm256_loadu_ps(x + k), _mm256_loadu_ps(y + k)));
+            }
+#endif
+            for (; k < size; k++)
+            {
+                y[k] += a * x[k];
+            }
+        }
+
+        // Transposes a PyTorch linear weight (output_size rows of input_size floats).
+        std::vector<float> transpose(const std::vector<float> &weights, int output_size, int input_size)
+        {
+            std::vector<float> transposed(weights.size());
+            for (int o = 0; o < output_size; o++)
+            {
+                for (int i = 0; i < input_size; i++)
+                {
+                    transposed[i * output_size + o] = weights[o * input_size + i];
+                }
+            }
+            return transposed;
+        }
+    }
+
+    bool is_native_model_file(const std::string &model_path)
+    {
+        std::ifstream file(model_path, std::ios::binary);
+        char magic[4];
+        return file.read(magic, sizeof(magic)) && std::memcmp(magic, NATIVE_MODEL_MAGIC, sizeof(magic)) == 0;
+    }
+
+    NativeNetwork::NativeNetwork(const std::string &model_path)
+    {
+        WeightReader reader(model_path);
+
+        char magic[4];
+        reader.read_bytes(magic, sizeof(magic));
+        int version = (std::memcmp(magic, NATIVE_MODEL_MAGIC, sizeof(magic)) == 0) ? reader.read_int() : -1;
+        if (version != NATIVE_MODEL_VERSION && version != SAVED_MODEL_VERSION)
+        {
+            throw std::runtime_error("Not a native model file (or unsupported version): " + model_path);
+        }
+
+        nb_nodes_ = reader.read_int();
+        input_channels_ = reader.read_int();
+        nb_channels_ = reader.read_int();
+        int nb_blocks = reader.read_int();
+        int action_size = reader.read_int();
+        value_head_channels_ = reader.read_int();
+
+        // Sparse normalized adjacency matrix.
+        std::vector<float> adjacency = reader.read_floats(nb_nodes_ * nb_nodes_);
+        adjacency_offsets_.push_back(0);
+        for (int n = 0; n < nb_nodes_; n++)
+        {
+            for (int m = 0; m < nb_nodes_; m++)
+            {
+                if (adjacency[n * nb_nodes_ + m] != 0.0f)
+                {
+                    adjacency_columns_.push_back(m);
+                    adjacency_values_.push_back(adjacency[n * nb_nodes_ + m]);
+                }
+            }
+            adjacency_offsets_.push_back(adjacency_columns_.size());
+        }
+
+        // A saved network holds its layers as they are used by the forward pass.
+        if (version == SAVED_MODEL_VERSION)
+        {
+            residual_convolutions_.resize(2 * nb_blocks);
+            for (DenseLayer *layer : layers())
+            {
+                layer->input_size = reader.read_int();
+                layer->output_size = reader.read_int();
+                layer->input_scale = 1.0;
+                if (reader.read_int() != 0)
+                {
+                    layer->quantized_weights = reader.read_int8s((layer->input_size + 3) / 4 * layer->output_size * 4);
+                    layer->scales = reader.read_floats(layer->output_size);
+                    layer->input_scale = reader.read_floats(1)[0];
+                }
+                else
+                {
+                    layer->weights = reader.read_floats(layer->input_size * layer->output_size);
+                }
+                layer->bias = reader.read_floats(layer->output_size);
+            }
+            if (policy_dense_.output_size != action_size)
+            {
+                throw std::runtime_error("Corrupted model file " + model_path);
+            }
+            return;
+        }
+
+        // Reads a linear layer.
+        auto read_dense = [&reader](int input_size, int output_size)
+        {
+            DenseLayer layer;
+            layer.input_size = input_size;
+            layer.output_size = output_size;
+            layer.weights = transpose(reader.read_floats(output_size * input_size), output_size, input_size);
+            layer.input_scale = 1.0;
+            layer.bias = reader.read_floats(output_size);
+            return layer;
+        };
+
+        // Reads a graph convolution and its BatchNorm, and folds the BatchNorm into the linear layer:
+        // BN(Wx + b) = (s * W)x + s * (b - mean) + beta, with s = gamma / sqrt(var + eps).
+        auto read_convolution = [&reader, &read_dense](int input_size, int output_size)
+        {
+            DenseLayer layer = read_dense(input_size, output_size);
+            std::vector<float> gamma = reader.read_floats(output_size);
+            std::vector<float> beta = reader.read_floats(output_size);
+            std::vector<float> mean = reader.read_floats(output_size);
+            std::vector<float> variance = reader.read_floats(output_size);
+            float epsilon = reader.read_floats(1)[0];
+
+            for (int o = 0; o < output_size; o++)
+            {
+                float scale = gamma[o] / std::sqrt(variance[o] + epsilon);
+                for (int i = 0; i < input_size; i++)
+                {
+                    layer.weights[i * output_size + o] *= scale;
+                }
+                layer.bias[o] = scale * (layer.bias[o] - mean[o]) + beta[o];
+            }
+            return layer;
+        };
+
+        // The heads flatten the (channel, node) output of their convolution channel-major, while the
+        // convolution writes it node-major: the input rows of the linear layer are reordered accordingly.
+        auto reorder_rows = [this](DenseLayer &layer, int nb_head_channels)
+        {
+            std::vector<float> reordered(layer.weights.size());
+            for (int c = 0; c < nb_head_channels; c++)
+            {
+                for (int n = 0; n < nb_nodes_; n++)
+                {
+                    std::memcpy(reordered.data() + (n * nb_head_channels + c) * layer.output_size,
+                                layer.weights.data() + (c * nb_nodes_ + n) * layer.output_size,
+                                sizeof(float) * layer.output_size);
+                }
+            }
+            layer.weights = reordered;
+        };
+
+        initial_convolution_ = read_convolution(input_channels_, nb_channels_);
+        for (int k = 0; k < 2 * nb_blocks; k++)
+        {
+            residual_convolutions_.push_back(read_convolution(nb_channels_, nb_channels_));
+        }
+
+        policy_convolution_ = read_convolution(nb_channels_, 2);
+        policy_dense_ = read_dense(2 * nb_nodes_, action_size);
+        reorder_rows(policy_dense_, 2);
+
+        value_convolution_ = read_convolution(nb_channels_, value_head_channels_);
+        value_dense_1_ = read_dense(value_head_channels_ * nb_nodes_, nb_channels_);
+        reorder_rows(value_dense_1_, value_head_channels_);
+        value_dense_2_ = read_dense(nb_channels_, 1);
+    }
+
+    int NativeNetwork::action_size() const
+    {
+        return policy_dense_.output_size;
+    }
+
+    bool NativeNetwork::is_quantized() const
+    {
+        return !initial_convolution_.quantized_weights.empty();
+    }
+
+    std::vector<NativeNetwork::DenseLayer *> NativeNetwork::layers()
+    {
+        std::vector<DenseLayer *> all_layers = {&initial_convolution_};
+        for (DenseLayer &layer : residual_convolutions_)
+        {
+            all_layers.push_back(&layer);
+        }
+        all_layers.insert(all_layers.end(), {&policy_convolution_, &policy_dense_, &value_convolution_, &value_dense_1_, &value_dense_2_});
+        return all_layers;
+    }
+
+    std::vector<const NativeNetwork::DenseLayer *> NativeNetwork::layers() const
+    {
+        std::vector<DenseLayer *> all_layers = const_cast<NativeNetwork *>(this)->layers();
+        return std::vector<const DenseLayer *>(all_layers.begin(), all_layers.end());
+    }
+
+    void NativeNetwork::quantize_layer(DenseLayer &layer, float weight_clip_ratio, float input_range)
+    {
+        const int nb_groups = (layer.input_size + 3) / 4;
+        layer.quantized_weights.assign(nb_groups * layer.output_size * 4, 0);
+        layer.scales.resize(layer.output_size);
+        layer.input_scale = (input_range > 0.0f) ? input_range / MAX_QUANTIZED_ACTIVATION : 1.0f;
+
+        for (int o = 0; o < layer.output_size; o++)
+        {
+            float max_weight = 0.0;
+            for (int i = 0; i < layer.input_size; i++)
+            {
+                max_weight = std::max(max_weight, std::fabs(layer.weights[i * layer.output_size + o]));
+            }
+            float scale = (max_weight > 0.0f) ? weight_clip_ratio * max_weight / 127.0f : 1.0f;
+            layer.scales[o] = scale;
+
+            for (int i = 0; i < layer.input_size; i++)
+            {
+                float quantized = std::round(layer.weights[i * layer.output_size + o] / scale);
+                layer.quantized_weights[((i / 4) * layer.output_size + o) * 4 + i % 4] = static_cast<std::int8_t>(std::clamp(quantized, -127.0f, 127.0f));
+            }
+        }
+    }
+
+    QuantizationReport NativeNetwork::quantize(const float *states, int nb_states)
+    {
+        if (is_quantized())
+        {
+            throw std::runtime_error("The network is already quantized");
+        }
+        const int nb_moves = action_size();
+
+        // Outputs of the full precision network.
+        std::vector<float> reference_logits(nb_states * nb_moves);
+        std::vector<float> reference_values(nb_states);
+        forward(states, nb_states, reference_logits.data(), reference_values.data());
+
+        std::vector<float> logits(nb_states * nb_moves);
+        std::vector<float> values(nb_states);
+
+        // Compares the outputs of the network to the full precision ones.
+        auto compare = [&]()
+        {
+            forward(states, nb_states, logits.data(), values.data());
+
+            QuantizationReport report = {0.0, 0.0, nb_states};
+            for (int b = 0; b < nb_states; b++)
+            {
+                const float *p = reference_logits.data() + b * nb_moves;
+                const float *q = logits.data() + b * nb_moves;
+
+                // Log-sum-exp of both logits, for the log-softmax.
+                float max_p = *std::max_element(p, p + nb_moves);
+                float max_q = *std::max_element(q, q + nb_moves);
+                double sum_p = 0.0;
+                double sum_q = 0.0;
+                for (int k = 0; k < nb_moves; k++)
+                {
+                    sum_p += std::exp(p[k] - max_p);
+                    sum_q += std::exp(q[k] - max_q);
+                }
+                double log_norm_p = max_p + std::log(sum_p);
+                double log_norm_q = max_q + std::log(sum_q);
+
+                double kl = 0.0;
+                for (int k = 0; k < nb_moves; k++)
+                {
+                    double log_p = p[k] - log_norm_p;
+                    double log_q = q[k] - log_norm_q;
+                    kl += std::exp(log_p) * (log_p - log_q);
+                }
+                report.policy_kl += kl;
+
+                float value_error = values[b] - reference_values[b];
+                report.value_mse += value_error * value_error;
+            }
+            if (nb_states > 0)
+            {
+                report.policy_kl /= nb_states;
+                report.value_mse /= nb_states;
+            }
+            return report;
+        };
+
+        // Largest input of each layer on the positions, with the full precision network.
+        std::vector<float> input_ranges(layers().size(), 0.0);
+        forward(states, nb_states, logits.data(), values.data(), input_ranges.data());
+
+        // Calibration: the layers are quantized one after the other, each with the clipping ratios of its weights and
+        // of its inputs giving the best outputs, given the layers already quantized.
+        std::vector<DenseLayer *> all_layers = layers();
+        for (int k = 0; k < static_cast<int>(all_layers.size()); k++)
+        {
+            float best_weight_ratio = 1.0;
+            float best_input_ratio = 1.0;
+            float best_error = std::numeric_limits<float>::infinity();
+            for (float weight_ratio : QUANTIZATION_CLIP_RATIOS)
+            {
+                for (float input_ratio : QUANTIZATION_CLIP_RATIOS)
+                {
+                    quantize_layer(*all_layers[k], weight_ratio, input_ratio * input_ranges[k]);
+                    QuantizationReport report = compare();
+                    if (report.policy_kl + report.value_mse < best_error)
+                    {
+                        best_error = report.policy_kl + report.value_mse;
+                        best_weight_ratio = weight_ratio;
+                        best_input_ratio = input_ratio;
+                    }
+                }
+            }
+            quantize_layer(*all_layers[k], best_weight_ratio, best_input_ratio * input_ranges[k]);
+        }
+
+        // The fp32 weights are not needed anymore.
+        for (DenseLayer *layer : layers())
+        {
+            layer->weights = std::vector<float>();
+        }
+
+        return compare();
+    }
+
+    void NativeNetwork::save(const std::string &model_path) const
+    {
+        std::ofstream file(model_path, std::ios::binary);
+        if (!file)
+        {
+            throw std::runtime_error("Cannot open the model file " + model_path);
+        }
+
+        auto write_ints = [&file](std::initializer_list<std::int32_t> values)
+        {
+            for (std::int32_t value : values)
+            {
+                file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+            }
+        };
+        auto write_floats = [&file](const std::vector<float> &values)
+        {
+            file.write(reinterpret_cast<const char *>(values.data()), sizeof(float) * values.size());
+        };
+
+        file.write(NATIVE_MODEL_MAGIC, sizeof(NATIVE_MODEL_MAGIC));
+        write_ints({SAVED_MODEL_VERSION, nb_nodes_, input_channels_, nb_channels_, static_cast<std::int32_t>(residual_convolutions_.size() / 2), action_size(), value_head_channels_});
+
+        // The adjacency matrix is saved dense, as in the exported files.
+        std::vector<float> adjacency(nb_nodes_ * nb_nodes_, 0.0);
+        for (int n = 0; n < nb_nodes_; n++)
+        {
+            for (int k = adjacency_offsets_[n]; k < adjacency_offsets_[n + 1]; k++)
+            {
+                adjacency[n * nb_nodes_ + adjacency_columns_[k]] = adjacency_values_[k];
+            }
+        }
+        write_floats(adjacency);
+
+        for (const DenseLayer *layer : layers())
+        {
+            bool quantized = !layer->quantized_weights.empty();
+            write_ints({layer->input_size, layer->output_size, quantized});
+            if (quantized)
+            {
+                file.write(reinterpret_cast<const char *>(layer->quantized_weights.data()), layer->quantized_weights.size());
+                write_floats(layer->scales);
+                write_floats({layer->input_scale});
+            }
+            else
+            {
+                write_floats(layer->weights);
+            }
+            write_floats(layer->bias);
+        }
+
+        if (!file)
+        {
+            throw std::runtime_error("Cannot write the model file " + model_path);
+        }
+    }
+
+    void NativeNetwork::dense(const float *input, int rows, const DenseLayer &layer, bool bias, bool relu, float *output, float *input_range)
+    {
+        if (input_range != nullptr)
+        {
+            *input_range = std::max(*input_range, *std::max_element(input, input + rows * layer.input_size));
+        }
+
+        for (int r = 0; r < rows; r++)
+        {
+            float *output_row = output + r * layer.output_size;
+            const float *init = (bias) ? layer.bias.data() : nullptr;
+            if (!layer.quantized_weights.empty())
+            {
+                quantized_dense_row(input + r * layer.input_size, layer.input_size, layer.quantized_weights.data(), layer.output_size, layer.input_scale, layer.scales.data(), init, output_row);
+            }
+            else
+            {
+                dense_row(input + r * layer.input_size, layer.input_size, layer.weights.data(), layer.output_size, init, output_row);
+            }
+
+            if (relu)
+            {
+                for (int o = 0; o < layer.output_size; o++)
+                {
+                    output_row[o] = std::max(output_row[o], 0.0f);
+                }
+            }
+        }
+    }
+
+    void NativeNetwork::graph_convolution(const float *input, int batch_size, const DenseLayer &layer, const float *residual, float *buffer, float *output, float *input_range) const
+    {
+        const int channels = layer.output_size;
+
+        // (A X) W + b = A (X W) + b: the linear layer is applied first, which benefits from the sparse inputs.
+        dense(input, batch_size * nb_nodes_, layer, false, false, buffer, input_range);
+
+        for (int b = 0; b < batch_size; b++)
+        {
+            const float *transformed = buffer + b * nb_nodes_ * channels;
+            for (int n = 0; n < nb_nodes_; n++)
+            {
+                float *output_row = output + (b * nb_nodes_ + n) * channels;
+
+                // The residual connection may be computed in place: its row is read before being overwritten.
+                if (residual != nullptr)
+                {
+                    const float *residual_row = residual + (b * nb_nodes_ + n) * channels;
+                    for (int c = 0; c < channels; c++)
+                    {
+                        output_row[c] = residual_row[c] + layer.bias[c];
+                    }
+                }
+                else
+                {
+                    std::memcpy(output_row, layer.bias.data(), sizeof(float) * channels);
+                }
+
+                for (int k = adjacency_offsets_[n]; k < adjacency_offsets_[n + 1]; k++)
+                {
+                    axpy(adjacency_values_[k], transformed + adjacency_columns_[k] * channels, output_row, channels);
+                }
+
+                for (int c = 0; c < channels; c++)
+                {
+                    output_row[c] = std::max(output_row[c], 0.0f);
+                }
+            }
+        }
+    }
+
+    void NativeNetwork::forward(const float *states, int batch_size, float *policy_logits, float *values) const
+    {
+        forward(states, batch_size, policy_logits, values, nullptr);
+    }
+
+    void NativeNetwork::forward(const float *states, int batch_size, float *policy_logits, float *values, float *input_ranges) const
+    {
+        if (batch_size <= 0)
+        {
+            return;
+        }
+
+        // Three node feature buffers of the residual tower, and one buffer for the value head.
+        const int node_features_size = batch_size * nb_nodes_ * std::max(nb_channels_, value_head_channels_);
+        const int value_hidden_size = batch_size * nb_channels_;
+        if (static_cast<int>(workspace.size()) < 3 * node_features_size + value_hidden_size)
+        {
+            workspace.resize(3 * node_features_size + value_hidden_size);
+        }
+        float *x = workspace.data();
+        float *y = x + node_features_size;
+        float *buffer = y + node_features_size;
+        float *value_hidden = buffer + node_features_size;
+
+        // Input range of the next layer, in the order of 'layers', if they are recorded.
+        int layer_index = 0;
+        auto next_range = [input_ranges, &layer_index]()
+        {
+            return (input_ranges != nullptr) ? input_ranges + layer_index++ : nullptr;
+        };
+
+        // Residual tower.
+        graph_convolution(states, batch_size, initial_convolution_, nullptr, buffer, x, next_range());
+        for (int k = 0; k < static_cast<int>(residual_convolutions_.size()); k += 2)
+        {
+            graph_convolution(x, batch_size, residual_convolutions_[k], nullptr, buffer, y, next_range());
+            graph_convolution(y, batch_size, residual_convolutions_[k + 1], x, buffer, x, next_range());
+        }
+
+        // Policy head.
+        graph_convolution(x, batch_size, policy_convolution_, nullptr, buffer, y, next_range());
+        dense(y, batch_size, policy_dense_, true, false, policy_logits, next_range());
+
+        // Value head.
+        graph_convolution(x, batch_size, value_convolution_, nullptr, buffer, y, next_range());
+        dense(y, batch_size, value_dense_1_, true, true, value_hidden, next_range());
+        dense(value_hidden, batch_size, value_dense_2_, true, false, values, next_range());
+        for (int b = 0; b < batch_size; b++)
+        {
+            values[b] = std::tanh(values[b]);
+        }
+    }
+}
@@ -1,8 +1,8 @@
 #include <random>
 #include "random_bot/random_bot.hpp"
 #include "game/state.hpp"
+#include "game/move.hpp"
 #include "game/move_iterator.hpp"
-#include "utils.hpp"
 
 // Implementation of 'random_bot', see 'include/random_bot/random_bot.hpp'.
 namespace random_bot
@@ -20,8 +20,8 @@ namespace random_bot
         // Counter for the number of possible legal moves seen so far.
         int nb_seen_elements = 0;
 
-        // Placeholder for the potential next game state.
-        game::GameState child;
+        // Placeholder for the selected move.
+        game::Move chosen_move;
 
         // Iterating through all possible moves from the current game state.
         for (const std::pair<int, game::GameState> &move : game::MoveGenerator(state))
@@ -29,14 +29,14 @@ namespace random_bot
             nb_seen_elements++;
             float random_number = dis(gen);
 
-            // On the fly uniform selection of the next game state.
+            // On the fly uniform selection of the move.
             if (random_number * nb_seen_elements <= 1.0)
             {
-                child = move.second;
+                chosen_move = game::Move(move.first);
             }
         }
         // Convert the selected move to the required Python format and return.
-        return move_to_python_format(state, child);
+        return game::move_to_python_format(state, chosen_move);
     }
 
     std::pair<int, int> random_bot(bool yellow_is_playing,
@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <torch/torch.h>
+#include "game/game_constants.hpp"
+#include "game/rules.hpp"
+#include "iris_zero/inference_server.hpp"
+#include "iris_zero/iris_zero_constants.hpp"
+#include "iris_zero/iris_zero_search.hpp"
+#include "iris_zero/reanalyse.hpp"
+#include "iris_zero/sample_shard.hpp"
+#include "iris_zero/simulation_scheduler.hpp"
+
+// Implementation of the reanalyse of self-play shards, see 'include/iris_zero/reanalyse.hpp'.
+namespace iris_zero
+{
+    // The search of a stored position, and the record it rewrites.
+    struct ReanalyseTask : public RootSearch
+    {
+        ReanalyseTask(const game::GameState &state, std::uint8_t *record, float stored_value) : RootSearch(state),
+                                                                                               record(record),
+                                                                                               stored_value(stored_value) {}
+
+        std::uint8_t *record;
+        float stored_value;
+    };
+
+    // Rewrites the record of a searched position with its refreshed targets.
+    void write_reanalysed_record(const ReanalyseTask &task, float value_weight)
+    {
+        Node *root_node = task.root_node.get();
+        torch::Tensor policy = node_mcts_policy(root_node);
+        float value = (1.0f - value_weight) * task.stored_value + value_weight * task.value();
+
+        // The legal moves of the position are unchanged, and so is the size of its record.
+        std::uint8_t record[MAX_SAMPLE_RECORD_SIZE];
+        int size = encode_sample_record(root_node->state, policy.data_ptr<float>(), value, record);
+        if (size == sample_record_size(task.record))
+        {
+            std::memcpy(task.record, record, size);
+        }
+    }
+
+    long reanalyse_shard(
+        const std::string &shard_path,
+        const std::string &model_path,
+        int nb_simulations,
+        float value_weight,
+        int nb_threads,
+        int batch_size,
+        long first_record,
+        long nb_records)
+    {
+        InferenceServer server(load_model(model_path), batch_size, std::chrono::microseconds(INFERENCE_MAX_WAIT_MICROSECONDS), INFERENCE_CACHE_SIZE);
+
+        // The shard is mapped for writing: the records are rewritten in place.
+        int fd = open(shard_path.c_str(), O_RDWR);
+        if (fd < 0)
+        {
+            throw std::runtime_error("Cannot open the shard: " + shard_path);
+        }
+        struct stat file_status;
+        if (fstat(fd, &file_status) != 0 || file_status.st_size == 0)
+        {
+            close(fd);
+            throw std::runtime_error("Not a valid self-play shard: " + shard_path);
+        }
+        std::size_t size = file_status.st_size;
+        void *data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED)
+        {
+            throw std::runtime_error("Cannot map the shard: " + shard_path);
+        }
+        std::uint8_t *bytes = static_cast<std::uint8_t *>(data);
+
+        std::vector<std::int64_t> offsets;
+        try
+        {
+            offsets = index_shard(bytes, size, shard_path);
+        }
+        catch (...)
+        {
+            munmap(data, size);
+            throw;
+        }
+
+        long begin = std::clamp(first_record, 0L, static_cast<long>(offsets.size()));
+        long end = (nb_records < 0) ? static_cast<long>(offsets.size()) : std::min(static_cast<long>(offsets.size()), begin + nb_records);
+
+        // The policy of a search is its distribution of the visits of the root after the first one.
+        nb_simulations = std::max(2, nb_simulations);
+        value_weight = std::clamp(value_weight, 0.0f, 1.0f);
+        nb_threads = std::max(1, nb_threads);
+        int nb_searches_per_thread = std::max(1, (batch_size + nb_threads - 1) / nb_threads);
+
+        std::atomic<long> next_record(begin);
+        std::atomic<long> nb_reanalysed(0);
+
+        // The next stored position to search, skipping the positions already won.
+        auto start_search = [&]() -> std::unique_ptr<ReanalyseTask>
+        {
+            for (long record_index = next_record.fetch_add(1); record_index < end; record_index = next_record.fetch_add(1))
+            {
+                std::uint8_t *record = bytes + offsets[record_index];
+
+                game::GameState state;
+                float policy[game::MAX_MVTS];
+                float stored_value;
+                decode_sample_record(record, &state, policy, &stored_value);
+                if (game::exists_winner(state))
+                {
+                    continue;
+                }
+
+                auto task = std::make_unique<ReanalyseTask>(state, record, stored_value);
+                task->search = std::make_unique<SimulationSearch>(task->root_node.get(), nb_simulations, -1.0, BATCH_SEARCH_EVALUATIONS_IN_FLIGHT);
+                return task;
+            }
+            return nullptr;
+        };
+
+        auto finish_search = [&](ReanalyseTask &task)
+        {
+            write_reanalysed_record(task, value_weight);
+            nb_reanalysed++;
+        };
+
+        // Each worker thread keeps 'nb_searches_per_thread' positions searched at the same time.
+        auto worker_loop = [&]()
+        {
+            run_searches<ReanalyseTask>(server, nb_searches_per_thread, BATCH_SEARCH_EVALUATIONS_IN_FLIGHT, start_search, finish_search);
+        };
+
+        std::vector<std::thread> workers;
+        for (int k = 0; k < nb_threads; k++)
+        {
+            workers.emplace_back(worker_loop);
+        }
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+
+        msync(data, size, MS_SYNC);
+        munmap(data, size);
+        return nb_reanalysed;
+    }
+}
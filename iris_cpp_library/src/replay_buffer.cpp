@@ -0,0 +1,242 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <torch/torch.h>
+#include "utils.hpp"
+#include "game/game_constants.hpp"
+#include "game/state.hpp"
+#include "game/symmetry.hpp"
+#include "iris_zero/iris_zero_constants.hpp"
+#include "iris_zero/replay_buffer.hpp"
+#include "iris_zero/sample_shard.hpp"
+
+// Implementation of the replay buffer, see 'include/iris_zero/replay_buffer.hpp'.
+namespace iris_zero
+{
+    ReplayBuffer::ReplayBuffer(
+        const std::vector<std::string> &shard_paths,
+        int batch_size,
+        float recency_exponent,
+        bool augment,
+        unsigned int seed) : batch_size_(batch_size),
+                             recency_exponent_(std::max(0.0f, recency_exponent)),
+                             augment_(augment),
+                             shards_(),
+                             records_(),
+                             gen_(seed),
+                             ready_batch_(-1),
+                             returned_batch_(-1),
+                             stop_(false)
+    {
+        for (TrainingSample &batch : batches_)
+        {
+            batch = std::make_tuple(torch::empty({batch_size_, game::NUMBER_REAL_NODES, NUMBER_ATRIBUTES}),
+                                    torch::empty({batch_size_, game::MAX_MVTS}),
+                                    torch::empty({batch_size_}));
+        }
+
+        try
+        {
+            for (const std::string &shard_path : shard_paths)
+            {
+                map_shard(shard_path);
+            }
+        }
+        catch (...)
+        {
+            for (const MappedShard &shard : shards_)
+            {
+                munmap(const_cast<std::uint8_t *>(shard.data), shard.size);
+            }
+            throw;
+        }
+
+        prefetch_thread_ = std::thread(&ReplayBuffer::prefetch_loop, this);
+    }
+
+    ReplayBuffer::~ReplayBuffer()
+    {
+        {
+            std::lock_guard<std::mutex> lock(batch_mutex_);
+            stop_ = true;
+        }
+        batch_condition_.notify_all();
+        prefetch_thread_.join();
+
+        for (const MappedShard &shard : shards_)
+        {
+            munmap(const_cast<std::uint8_t *>(shard.data), shard.size);
+        }
+    }
+
+    void ReplayBuffer::add_shard(const std::string &shard_path)
+    {
+        {
+            std::lock_guard<std::mutex> lock(index_mutex_);
+            map_shard(shard_path);
+        }
+
+        // The background thread may be waiting for the first positions.
+        {
+            std::lock_guard<std::mutex> lock(batch_mutex_);
+        }
+        batch_condition_.notify_all();
+    }
+
+    long ReplayBuffer::size() const
+    {
+        std::lock_guard<std::mutex> lock(index_mutex_);
+        return records_.size();
+    }
+
+    TrainingSample ReplayBuffer::sample()
+    {
+        if (size() == 0)
+        {
+            throw std::runtime_error("Cannot sample from an empty replay buffer");
+        }
+
+        std::unique_lock<std::mutex> lock(batch_mutex_);
+        batch_condition_.wait(lock, [this]
+                              { return ready_batch_ != -1; });
+
+        // The previously returned minibatch can now be overwritten by the background thread.
+        returned_batch_ = ready_batch_;
+        ready_batch_ = -1;
+        lock.unlock();
+        batch_condition_.notify_all();
+
+        return batches_[returned_batch_];
+    }
+
+    void ReplayBuffer::map_shard(const std::string &shard_path)
+    {
+        int fd = open(shard_path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            throw std::runtime_error("Cannot open the shard: " + shard_path);
+        }
+
+        struct stat file_status;
+        if (fstat(fd, &file_status) != 0)
+        {
+            close(fd);
+            throw std::runtime_error("Cannot read the shard: " + shard_path);
+        }
+        std::size_t size = file_status.st_size;
+
+        // An empty file is rejected by 'index_shard', and cannot be mapped.
+        if (size == 0)
+        {
+            close(fd);
+            index_shard(nullptr, 0, shard_path);
+        }
+
+        void *data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED)
+        {
+            throw std::runtime_error("Cannot map the shard: " + shard_path);
+        }
+
+        // The records are read in a random order, so reading ahead is useless.
+        madvise(data, size, MADV_RANDOM);
+
+        const std::uint8_t *bytes = static_cast<const std::uint8_t *>(data);
+        std::vector<std::int64_t> offsets;
+        try
+        {
+            offsets = index_shard(bytes, size, shard_path);
+        }
+        catch (...)
+        {
+            munmap(data, size);
+            throw;
+        }
+
+        shards_.push_back({bytes, size});
+        records_.reserve(records_.size() + offsets.size());
+        for (std::int64_t offset : offsets)
+        {
+            records_.push_back(bytes + offset);
+        }
+    }
+
+    void ReplayBuffer::fill_batch(TrainingSample &batch)
+    {
+        float *positions_data = std::get<0>(batch).data_ptr<float>();
+        float *policies_data = std::get<1>(batch).data_ptr<float>();
+        float *values_data = std::get<2>(batch).data_ptr<float>();
+
+        std::lock_guard<std::mutex> lock(index_mutex_);
+        long nb_records = records_.size();
+
+        // The rank of a position, scaled to [0, 1], is drawn with a density proportional to the rank to the power of
+        // the recency exponent, by inverting its cumulative distribution.
+        std::uniform_real_distribution<double> uniform_dist(0.0, 1.0);
+        std::uniform_int_distribution<int> symmetry_dist(0, game::NUMBER_SYMMETRIES - 1);
+        double inverse_exponent = 1.0 / (recency_exponent_ + 1.0);
+
+        game::GameState state;
+        float policy[game::MAX_MVTS];
+        for (int k = 0; k < batch_size_; k++)
+        {
+            double rank = std::pow(uniform_dist(gen_), inverse_exponent);
+            long record = std::min(nb_records - 1, static_cast<long>(rank * nb_records));
+
+            float *position_planes = positions_data + k * game::NUMBER_REAL_NODES * NUMBER_ATRIBUTES;
+            float *position_policy = policies_data + k * game::MAX_MVTS;
+            if (!augment_)
+            {
+                expand_sample_record(records_[record], position_planes, position_policy, values_data + k);
+                continue;
+            }
+
+            // Swapping the players (the upper half of the transformations) changes the sign of the value for yellow.
+            decode_sample_record(records_[record], &state, policy, values_data + k);
+            int symmetry = symmetry_dist(gen_);
+            game::transform_policy(state, policy, symmetry, position_policy);
+            encode_game_state(game::transform_game_state(state, symmetry), position_planes);
+            if (symmetry >= 2 * game::NUMBER_BOARD_SYMMETRIES)
+            {
+                values_data[k] = -values_data[k];
+            }
+        }
+    }
+
+    void ReplayBuffer::prefetch_loop()
+    {
+        while (true)
+        {
+            // Wait until the ready minibatch has been returned, and there are positions to sample.
+            int filled_batch;
+            {
+                std::unique_lock<std::mutex> lock(batch_mutex_);
+                batch_condition_.wait(lock, [this]
+                                      { return stop_ || (ready_batch_ == -1 && size() > 0); });
+                if (stop_)
+                {
+                    return;
+                }
+                filled_batch = (returned_batch_ == 0) ? 1 : 0;
+            }
+
+            fill_batch(batches_[filled_batch]);
+
+            {
+                std::lock_guard<std::mutex> lock(batch_mutex_);
+                ready_batch_ = filled_batch;
+            }
+            batch_condition_.notify_all();
+        }
+    }
+}
@@ -0,0 +1,216 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <torch/torch.h>
+#include "utils.hpp"
+#include "game/game_constants.hpp"
+#include "game/packed_state.hpp"
+#include "game/rules.hpp"
+#include "iris_zero/iris_zero_constants.hpp"
+#include "iris_zero/sample_shard.hpp"
+
+// Implementation of the self-play shards, see 'include/iris_zero/sample_shard.hpp'.
+namespace iris_zero
+{
+    // Magic number and version of the shard format.
+    const char SHARD_MAGIC[4] = {'I', 'R', 'S', 'S'};
+    const std::uint32_t SHARD_VERSION = 2;
+
+    // Size of the buffer of a ShardWriter.
+    const std::size_t SHARD_WRITER_BUFFER_SIZE = 1 << 20;
+
+    int encode_sample_record(const game::GameState &state, const float *policy, float value, std::uint8_t *record)
+    {
+        game::PackedGameState packed = game::pack_game_state(state);
+        std::memcpy(record, packed.bytes, game::PACKED_STATE_SIZE);
+
+        std::int8_t quantized_value = static_cast<std::int8_t>(std::lround(127.0f * std::clamp(value, -1.0f, 1.0f)));
+        std::memcpy(record + game::PACKED_STATE_SIZE, &quantized_value, 1);
+
+        // Probabilities of the legal moves, relative to the largest one. A policy without any weight on the legal
+        // moves (such as the one recorded for a final position) is stored as the uniform one.
+        std::uint64_t legal_moves = game::legal_moves_mask(state);
+        float max_probability = 0.0;
+        for (std::uint64_t moves = legal_moves; moves != 0; moves &= moves - 1)
+        {
+            max_probability = std::max(max_probability, policy[__builtin_ctzll(moves)]);
+        }
+
+        std::uint8_t *quantized_policy = record + game::PACKED_STATE_SIZE + 2;
+        int nb_moves = 0;
+        for (std::uint64_t moves = legal_moves; moves != 0; moves &= moves - 1)
+        {
+            float probability = policy[__builtin_ctzll(moves)];
+            quantized_policy[nb_moves++] = (max_probability > 0.0) ? static_cast<std::uint8_t>(std::lround(255.0f * probability / max_probability)) : 255;
+        }
+        record[game::PACKED_STATE_SIZE + 1] = static_cast<std::uint8_t>(nb_moves);
+
+        return game::PACKED_STATE_SIZE + 2 + nb_moves;
+    }
+
+    int sample_record_size(const std::uint8_t *record)
+    {
+        return game::PACKED_STATE_SIZE + 2 + record[game::PACKED_STATE_SIZE + 1];
+    }
+
+    void decode_sample_record(const std::uint8_t *record, game::GameState *state, float *policy, float *value)
+    {
+        game::PackedGameState packed;
+        std::memcpy(packed.bytes, record, game::PACKED_STATE_SIZE);
+        *state = game::unpack_game_state(packed);
+
+        std::int8_t quantized_value;
+        std::memcpy(&quantized_value, record + game::PACKED_STATE_SIZE, 1);
+        *value = quantized_value / 127.0f;
+
+        // The policy is renormalized over the legal moves.
+        const std::uint8_t *quantized_policy = record + game::PACKED_STATE_SIZE + 2;
+        int nb_moves = record[game::PACKED_STATE_SIZE + 1];
+        float sum = 0.0;
+        for (int k = 0; k < nb_moves; k++)
+        {
+            sum += quantized_policy[k];
+        }
+
+        std::fill(policy, policy + game::MAX_MVTS, 0.0f);
+        std::uint64_t legal_moves = game::legal_moves_mask(*state);
+        for (int k = 0; k < nb_moves && legal_moves != 0; k++, legal_moves &= legal_moves - 1)
+        {
+            policy[__builtin_ctzll(legal_moves)] = (sum > 0.0) ? quantized_policy[k] / sum : 1.0f / nb_moves;
+        }
+    }
+
+    void expand_sample_record(const std::uint8_t *record, float *planes, float *policy, float *value, game::GameState *state)
+    {
+        game::GameState decoded_state;
+        decode_sample_record(record, &decoded_state, policy, value);
+        encode_game_state(decoded_state, planes);
+
+        if (state != nullptr)
+        {
+            *state = decoded_state;
+        }
+    }
+
+    std::vector<std::int64_t> index_shard(const std::uint8_t *data, std::size_t size, const std::string &shard_path)
+    {
+        std::uint32_t version = 0;
+        if (size >= static_cast<std::size_t>(SHARD_HEADER_SIZE))
+        {
+            std::memcpy(&version, data + 4, sizeof(version));
+        }
+        if (size < static_cast<std::size_t>(SHARD_HEADER_SIZE) || std::memcmp(data, SHARD_MAGIC, 4) != 0 || version != SHARD_VERSION)
+        {
+            throw std::runtime_error("Not a valid self-play shard: " + shard_path);
+        }
+
+        std::vector<std::int64_t> offsets;
+        std::size_t offset = SHARD_HEADER_SIZE;
+
+        // A record cut by an interrupted write is ignored.
+        while (offset + game::PACKED_STATE_SIZE + 2 <= size && offset + sample_record_size(data + offset) <= size)
+        {
+            offsets.push_back(offset);
+            offset += sample_record_size(data + offset);
+        }
+        return offsets;
+    }
+
+    ShardWriter::ShardWriter(const std::string &shard_path) : shard_path_(shard_path),
+                                                              file_(),
+                                                              buffer_(),
+                                                              nb_records_(0)
+    {
+        // An existing shard is appended to, after checking its header.
+        std::ifstream existing_file(shard_path, std::ios::binary);
+        char header[SHARD_HEADER_SIZE];
+        bool is_new = !existing_file || !existing_file.read(header, SHARD_HEADER_SIZE);
+        if (!is_new)
+        {
+            index_shard(reinterpret_cast<const std::uint8_t *>(header), SHARD_HEADER_SIZE, shard_path);
+        }
+        existing_file.close();
+
+        file_.open(shard_path, std::ios::binary | std::ios::app);
+        if (!file_)
+        {
+            throw std::runtime_error("Cannot open the shard: " + shard_path);
+        }
+
+        if (is_new)
+        {
+            file_.write(SHARD_MAGIC, 4);
+            file_.write(reinterpret_cast<const char *>(&SHARD_VERSION), sizeof(SHARD_VERSION));
+        }
+        buffer_.reserve(SHARD_WRITER_BUFFER_SIZE + MAX_SAMPLE_RECORD_SIZE);
+    }
+
+    ShardWriter::~ShardWriter()
+    {
+        flush();
+    }
+
+    void ShardWriter::write(const game::GameState &state, const float *policy, float outcome)
+    {
+        std::size_t size = buffer_.size();
+        buffer_.resize(size + MAX_SAMPLE_RECORD_SIZE);
+        buffer_.resize(size + encode_sample_record(state, policy, outcome, buffer_.data() + size));
+        nb_records_++;
+
+        if (buffer_.size() >= SHARD_WRITER_BUFFER_SIZE)
+        {
+            flush();
+        }
+    }
+
+    void ShardWriter::flush()
+    {
+        if (!buffer_.empty())
+        {
+            file_.write(reinterpret_cast<const char *>(buffer_.data()), buffer_.size());
+            buffer_.clear();
+        }
+        file_.flush();
+    }
+
+    long ShardWriter::nb_records() const
+    {
+        return nb_records_;
+    }
+
+    TrainingSample load_shard(const std::string &shard_path)
+    {
+        std::ifstream file(shard_path, std::ios::binary);
+        if (!file)
+        {
+            throw std::runtime_error("Cannot open the shard: " + shard_path);
+        }
+        std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        std::vector<std::int64_t> offsets = index_shard(data.data(), data.size(), shard_path);
+        int nb_positions = offsets.size();
+
+        torch::Tensor positions = torch::empty({nb_positions, game::NUMBER_REAL_NODES, NUMBER_ATRIBUTES});
+        torch::Tensor policies = torch::empty({nb_positions, game::MAX_MVTS});
+        torch::Tensor values = torch::empty({nb_positions});
+
+        float *positions_data = positions.data_ptr<float>();
+        float *policies_data = policies.data_ptr<float>();
+        float *values_data = values.data_ptr<float>();
+        for (int k = 0; k < nb_positions; k++)
+        {
+            expand_sample_record(data.data() + offsets[k],
+                                 positions_data + k * game::NUMBER_REAL_NODES * NUMBER_ATRIBUTES,
+                                 policies_data + k * game::MAX_MVTS,
+                                 values_data + k);
+        }
+
+        return std::make_tuple(positions, policies, values);
+    }
+}
@@ -0,0 +1,118 @@
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include "async_search/search_handle.hpp"
+#include "game/game_constants.hpp"
+#include "game/rules.hpp"
+#include "random_bot/random_bot.hpp"
+#include "minmax_bot/minmax_bot.hpp"
+#include "mcts/mcts_bot.hpp"
+#include "iris_zero/iris_zero_bot.hpp"
+
+// Implementation of the 'SearchHandle' class, see 'include/async_search/search_handle.hpp'.
+namespace async_search
+{
+    SearchHandle::SearchHandle(const game::GameState &state, const arena::EngineConfig &engine, float reflexion_time) : stop_(false),
+                                                                                                                       best_move_(),
+                                                                                                                       is_finished_(false),
+                                                                                                                       error_(nullptr)
+    {
+        thread_ = std::thread(&SearchHandle::run, this, state, engine, reflexion_time);
+    }
+
+    SearchHandle::~SearchHandle()
+    {
+        stop_ = true;
+        thread_.join();
+    }
+
+    bool SearchHandle::poll() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return is_finished_;
+    }
+
+    std::optional<std::pair<int, int>> SearchHandle::best_so_far() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return best_move_;
+    }
+
+    void SearchHandle::stop()
+    {
+        stop_ = true;
+    }
+
+    std::pair<int, int> SearchHandle::result()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        finished_condition_.wait(lock, [this]
+                                 { return is_finished_; });
+        if (error_)
+        {
+            std::rethrow_exception(error_);
+        }
+        return *best_move_;
+    }
+
+    void SearchHandle::run(game::GameState state, arena::EngineConfig engine, float reflexion_time)
+    {
+        auto progress = [this](std::pair<int, int> move)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            best_move_ = move;
+        };
+
+        std::pair<int, int> move;
+        std::exception_ptr error = nullptr;
+        try
+        {
+            if (!game::exists_move(state))
+            {
+                move = std::make_pair(-1, -1);
+            }
+            else
+            {
+                switch (engine.type)
+                {
+                case arena::EngineType::RANDOM:
+                    move = random_bot::random_bot_int(state);
+                    break;
+                case arena::EngineType::MINMAX:
+                    move = minmax_bot::minmax_bot_int(engine.depth, state);
+                    break;
+                case arena::EngineType::MCTS:
+                    move = mcts::mcts_search_int(state, engine.nb_simulations, reflexion_time, stop_, progress);
+                    break;
+                case arena::EngineType::IRIS_ZERO:
+                    move = iris_zero::iris_zero_search_int(state, engine.nb_simulations, reflexion_time, engine.model_path, stop_, progress);
+                    break;
+                case arena::EngineType::IRIS_ZERO_GUMBEL:
+                    move = iris_zero::iris_zero_gumbel_search_int(state, engine.nb_simulations, reflexion_time, engine.model_path, stop_, progress);
+                    break;
+                }
+            }
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (error)
+            {
+                error_ = error;
+            }
+            else
+            {
+                best_move_ = move;
+            }
+            is_finished_ = true;
+        }
+        finished_condition_.notify_all();
+    }
+}
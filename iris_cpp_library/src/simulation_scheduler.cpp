@@ -0,0 +1,174 @@
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <utility>
+#include <vector>
+#include "game/rules.hpp"
+#include "iris_zero/simulation_scheduler.hpp"
+#include "iris_zero/iris_zero_search.hpp"
+
+// Implementation of the 'SimulationScheduler', 'SimulationSearch' and 'RootSearch' classes, see 'include/iris_zero/simulation_scheduler.hpp'.
+namespace iris_zero
+{
+    SimulationScheduler::SimulationScheduler(InferenceServer &server, int max_in_flight) : server_(server),
+                                                                                             max_in_flight_(std::max(1, max_in_flight)),
+                                                                                             tasks_(),
+                                                                                             next_task_(0),
+                                                                                             in_flight_() {}
+
+    void SimulationScheduler::add(SearchTask *task)
+    {
+        tasks_.push_back(task);
+    }
+
+    SearchTask *SimulationScheduler::run_until_finished()
+    {
+        while (!tasks_.empty())
+        {
+            // Start simulations, one search after the other, until the pipeline is full or no search can start one.
+            int nb_idle_tasks = 0;
+            while (static_cast<int>(in_flight_.size()) < max_in_flight_ && nb_idle_tasks < static_cast<int>(tasks_.size()))
+            {
+                next_task_ %= tasks_.size();
+                SearchTask *task = tasks_[next_task_];
+
+                Node *leaf = task->next_leaf();
+
+                if (leaf != nullptr)
+                {
+                    in_flight_.push_back({task, leaf, server_.submit(leaf->planes.data(), leaf->state)});
+                    nb_idle_tasks = 0;
+                    next_task_++;
+                }
+                else if (task->is_finished())
+                {
+                    tasks_.erase(tasks_.begin() + next_task_);
+                    return task;
+                }
+                else
+                {
+                    nb_idle_tasks++;
+                    next_task_++;
+                }
+            }
+
+            // A search that cannot start a simulation waits for its suspended ones.
+            if (!in_flight_.empty())
+            {
+                resume_simulations();
+            }
+        }
+        return nullptr;
+    }
+
+    void SimulationScheduler::resume_simulations()
+    {
+        Simulation simulation = std::move(in_flight_.front());
+        in_flight_.pop_front();
+        simulation.task->complete(simulation.leaf, simulation.evaluation.get());
+
+        // The evaluations of a batch are usually available together.
+        for (auto it = in_flight_.begin(); it != in_flight_.end();)
+        {
+            if (it->evaluation.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+            {
+                it->task->complete(it->leaf, it->evaluation.get());
+                it = in_flight_.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    SimulationSearch::SimulationSearch(
+        Node *root_node,
+        int nb_simulations,
+        float reflexion_time,
+        int max_in_flight) : root_node_(root_node),
+                             nb_simulations_(nb_simulations),
+                             reflexion_time_(reflexion_time),
+                             max_in_flight_(std::max(1, max_in_flight)),
+                             nb_launched_simulations_(0),
+                             nb_pending_simulations_(0),
+                             start_time_(std::chrono::steady_clock::now()) {}
+
+    Node *SimulationSearch::next_leaf()
+    {
+        while (nb_launched_simulations_ < nb_simulations_ && nb_pending_simulations_ < max_in_flight_ && !time_is_over())
+        {
+            Node *selected_node = select(root_node_);
+
+            // Already expanded terminal nodes are backpropagated with their stored value.
+            if (selected_node->is_expanded)
+            {
+                backpropagate(selected_node, selected_node->value);
+                nb_launched_simulations_++;
+                continue;
+            }
+
+            // The selection reached a leaf already waiting for its evaluation: wait for the suspended simulations.
+            if (selected_node->evaluation_pending)
+            {
+                return nullptr;
+            }
+
+            begin_evaluation(selected_node);
+            nb_launched_simulations_++;
+            nb_pending_simulations_++;
+            return selected_node;
+        }
+        return nullptr;
+    }
+
+    void SimulationSearch::complete(Node *leaf, const Evaluation &evaluation)
+    {
+        complete_evaluation(leaf, evaluation);
+        nb_pending_simulations_--;
+    }
+
+    bool SimulationSearch::is_finished() const
+    {
+        return nb_pending_simulations_ == 0 && (nb_launched_simulations_ >= nb_simulations_ || time_is_over());
+    }
+
+    bool SimulationSearch::time_is_over() const
+    {
+        return reflexion_time_ >= 0.0 && std::chrono::duration<float>(std::chrono::steady_clock::now() - start_time_).count() >= reflexion_time_;
+    }
+
+    void run_simulations(Node *root_node, InferenceServer &server, int nb_simulations, float reflexion_time, int max_in_flight)
+    {
+        SimulationSearch search(root_node, nb_simulations, reflexion_time, max_in_flight);
+
+        SimulationScheduler scheduler(server, max_in_flight);
+        scheduler.add(&search);
+        scheduler.run_until_finished();
+    }
+
+    RootSearch::RootSearch(const game::GameState &state) : root_node(std::make_unique<Node>(state)),
+                                                           search() {}
+
+    Node *RootSearch::next_leaf()
+    {
+        return search->next_leaf();
+    }
+
+    void RootSearch::complete(Node *leaf, const Evaluation &evaluation)
+    {
+        search->complete(leaf, evaluation);
+    }
+
+    bool RootSearch::is_finished() const
+    {
+        return search->is_finished();
+    }
+
+    float RootSearch::value() const
+    {
+        // The children's wins are counted for the player of the root, and its own wins for the other player.
+        float search_value = root_node->wins / root_node->visits;
+        return (root_node->state.yellow_is_playing) ? -search_value : search_value;
+    }
+}
@@ -0,0 +1,78 @@
+#include <cstdint>
+#include "game/game_constants.hpp"
+#include "game/rules.hpp"
+#include "game/solver.hpp"
+
+// Implementation of the endgame solver, see 'include/game/solver.hpp'.
+namespace game
+{
+    // Returns true if the current player can move their pawn to the outer pentagone (node 16 to 20).
+    bool has_winning_move(const GameState &state, std::uint64_t legal_moves)
+    {
+        int player_position = (state.yellow_is_playing) ? state.yellow_position : state.red_position;
+
+        // Only the moves of the player's pawn (the first MAX_MVT_PER_PAWN indexes) can win.
+        std::uint64_t pawn_moves = legal_moves & ((std::uint64_t(1) << MAX_MVT_PER_PAWN) - 1);
+        while (pawn_moves != 0)
+        {
+            int index = __builtin_ctzll(pawn_moves);
+            pawn_moves &= pawn_moves - 1;
+
+            if (NODE_NEIGHBOURS[player_position][index] >= 16)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    int solve(const GameState &state, int depth)
+    {
+        if (16 <= state.yellow_position && state.yellow_position <= 20)
+        {
+            return 1;
+        }
+        if (16 <= state.red_position && state.red_position <= 20)
+        {
+            return -1;
+        }
+        if (depth <= 0)
+        {
+            return 0;
+        }
+
+        int player = (state.yellow_is_playing) ? 1 : -1;
+        std::uint64_t legal_moves = legal_moves_mask(state);
+        auto apply_legal_move = (state.yellow_is_playing) ? &apply_move<true> : &apply_move<false>;
+
+        if (has_winning_move(state, legal_moves))
+        {
+            return player;
+        }
+
+        // No move can make the opponent win right away.
+        if (depth == 1)
+        {
+            return 0;
+        }
+
+        // The position is lost if every move is, and unknown if one of them is not proven.
+        int result = -player;
+        while (legal_moves != 0)
+        {
+            int move = __builtin_ctzll(legal_moves);
+            legal_moves &= legal_moves - 1;
+
+            int move_result = solve(apply_legal_move(state, move), depth - 1);
+            if (move_result == player)
+            {
+                return player;
+            }
+            if (move_result == 0)
+            {
+                result = 0;
+            }
+        }
+        return result;
+    }
+}
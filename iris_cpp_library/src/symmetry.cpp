@@ -0,0 +1,233 @@
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+#include "game/game_constants.hpp"
+#include "game/symmetry.hpp"
+
+// Implementation of the position symmetries, see 'include/game/symmetry.hpp'.
+namespace game
+{
+    // Permutation tables of the board automorphisms, computed once.
+    struct SymmetryTables
+    {
+        // Node each node is sent to.
+        int nodes[NUMBER_BOARD_SYMMETRIES][21];
+
+        // Bitfield of the transformed nodes of each group of seven nodes (1 to 7, 8 to 14 and 15 to 21), for each
+        // value of the corresponding seven bits of a bitfield of nodes.
+        int node_bits[NUMBER_BOARD_SYMMETRIES][3][128];
+
+        // For a pawn on a node, the index of each of its moves (neighbours) among the moves of the pawn on the
+        // transformed node.
+        int moves[NUMBER_BOARD_SYMMETRIES][21][10];
+
+        SymmetryTables()
+        {
+            // The nodes other than the center form four rings of five nodes: the k-th node of the i-th ring is
+            // node 5 * i + k + 1. Reflecting the board reverses the order of every ring, with a shift of one node
+            // for the second and fourth rings.
+            const int reflection_shifts[4] = {0, 4, 0, 4};
+            for (int symmetry = 0; symmetry < NUMBER_BOARD_SYMMETRIES; symmetry++)
+            {
+                int rotation = symmetry % 5;
+                bool reflection = symmetry >= 5;
+
+                nodes[symmetry][0] = 0;
+                for (int ring = 0; ring < 4; ring++)
+                {
+                    for (int k = 0; k < 5; k++)
+                    {
+                        int reflected = (reflection) ? (5 - k + reflection_shifts[ring]) % 5 : k;
+                        nodes[symmetry][5 * ring + k + 1] = 5 * ring + (reflected + rotation) % 5 + 1;
+                    }
+                }
+
+                for (int group = 0; group < 3; group++)
+                {
+                    for (int bits = 0; bits < 128; bits++)
+                    {
+                        node_bits[symmetry][group][bits] = 0;
+                        for (int k = 0; k < 7; k++)
+                        {
+                            int node = 7 * group + k + 1;
+                            if ((bits >> k) & 1 && node < NUMBER_REAL_NODES)
+                            {
+                                node_bits[symmetry][group][bits] |= 1 << nodes[symmetry][node];
+                            }
+                        }
+                    }
+                }
+
+                for (int node = 0; node < NUMBER_REAL_NODES; node++)
+                {
+                    for (int index = 0; index < NODE_NEIGHBOURS_SIZE[node]; index++)
+                    {
+                        int neighbour = nodes[symmetry][NODE_NEIGHBOURS[node][index]];
+                        moves[symmetry][node][index] = NODE_NEIGHBOUR_INDEXES[nodes[symmetry][node]][neighbour];
+                    }
+                }
+            }
+        }
+    };
+
+    // Returns the permutation tables, built on first use.
+    const SymmetryTables &symmetry_tables()
+    {
+        static const SymmetryTables tables;
+        return tables;
+    }
+
+    // Sends every node of a bitfield of nodes (node 0 excluded) through a board automorphism.
+    int transform_nodes(int board_symmetry, int bits)
+    {
+        const int(*node_bits)[128] = symmetry_tables().node_bits[board_symmetry];
+        return node_bits[0][(bits >> 1) & 127] | node_bits[1][(bits >> 8) & 127] | node_bits[2][(bits >> 15) & 127];
+    }
+
+    // Swaps the black and white pawns of a game state.
+    void swap_neutral_pawns(GameState &state)
+    {
+        std::swap(state.black_position, state.white_position);
+        std::swap(state.black_colors, state.white_colors);
+        std::swap(state.black_last_use, state.white_last_use);
+        std::swap(state.black_consecutive_last_use, state.white_consecutive_last_use);
+    }
+
+    // Swaps the players of a game state.
+    void swap_players(GameState &state)
+    {
+        state.yellow_is_playing = !state.yellow_is_playing;
+        std::swap(state.yellow_position, state.red_position);
+        std::swap(state.yellow_colors, state.red_colors);
+        state.black_last_use = !state.black_last_use;
+        state.white_last_use = !state.white_last_use;
+        state.orange_last_use = !state.orange_last_use;
+    }
+
+    int symmetric_node(int board_symmetry, int node)
+    {
+        return symmetry_tables().nodes[board_symmetry][node];
+    }
+
+    GameState transform_game_state(const GameState &state, int transformation)
+    {
+        int board_symmetry = transformation % NUMBER_BOARD_SYMMETRIES;
+        const int *nodes = symmetry_tables().nodes[board_symmetry];
+
+        GameState transformed = state;
+        transformed.yellow_position = nodes[state.yellow_position];
+        transformed.red_position = nodes[state.red_position];
+        transformed.black_position = nodes[state.black_position];
+        transformed.white_position = nodes[state.white_position];
+        transformed.orange_position = nodes[state.orange_position];
+        transformed.yellow_colors = transform_nodes(board_symmetry, state.yellow_colors);
+        transformed.red_colors = transform_nodes(board_symmetry, state.red_colors);
+        transformed.black_colors = transform_nodes(board_symmetry, state.black_colors);
+        transformed.white_colors = transform_nodes(board_symmetry, state.white_colors);
+
+        if ((transformation / NUMBER_BOARD_SYMMETRIES) % 2 == 1)
+        {
+            swap_neutral_pawns(transformed);
+        }
+
+        if (transformation >= 2 * NUMBER_BOARD_SYMMETRIES)
+        {
+            swap_players(transformed);
+        }
+
+        return transformed;
+    }
+
+    int transform_move(const GameState &state, int move, int transformation)
+    {
+        if (move == 4 * MAX_MVT_PER_PAWN)
+        {
+            return move;
+        }
+
+        // The player's pawn keeps its moves when the players are swapped.
+        int pawn = move / MAX_MVT_PER_PAWN;
+        int positions[4] = {(state.yellow_is_playing) ? state.yellow_position : state.red_position,
+                            state.black_position,
+                            state.white_position,
+                            state.orange_position};
+        int index = symmetry_tables().moves[transformation % NUMBER_BOARD_SYMMETRIES][positions[pawn]][move % MAX_MVT_PER_PAWN];
+
+        if ((transformation / NUMBER_BOARD_SYMMETRIES) % 2 == 1 && (pawn == 1 || pawn == 2))
+        {
+            pawn = 3 - pawn;
+        }
+        return pawn * MAX_MVT_PER_PAWN + index;
+    }
+
+    void transform_policy(const GameState &state, const float *policy, int transformation, float *transformed_policy)
+    {
+        std::fill(transformed_policy, transformed_policy + MAX_MVTS, 0.0f);
+
+        // Only the moves to an existing neighbour can have a probability.
+        int positions[4] = {(state.yellow_is_playing) ? state.yellow_position : state.red_position,
+                            state.black_position,
+                            state.white_position,
+                            state.orange_position};
+        for (int pawn = 0; pawn < 4; pawn++)
+        {
+            for (int index = 0; index < NODE_NEIGHBOURS_SIZE[positions[pawn]]; index++)
+            {
+                int move = pawn * MAX_MVT_PER_PAWN + index;
+                transformed_policy[transform_move(state, move, transformation)] = policy[move];
+            }
+        }
+        transformed_policy[4 * MAX_MVT_PER_PAWN] = policy[4 * MAX_MVT_PER_PAWN];
+    }
+
+    CanonicalGameState canonicalize(const GameState &state)
+    {
+        CanonicalGameState canonical;
+        canonical.state = state;
+        canonical.packed = pack_game_state(state);
+        canonical.transformation = 0;
+
+        // Keeps a transform if its packed form is smaller than the current representative.
+        auto consider = [&canonical](const GameState &transformed, int transformation)
+        {
+            PackedGameState packed = pack_game_state(transformed);
+            if (std::memcmp(packed.bytes, canonical.packed.bytes, PACKED_STATE_SIZE) < 0)
+            {
+                canonical.state = transformed;
+                canonical.packed = packed;
+                canonical.transformation = transformation;
+            }
+        };
+
+        // Each board automorphism is computed once, and its transform is then swapped in place.
+        for (int board_symmetry = 0; board_symmetry < NUMBER_BOARD_SYMMETRIES; board_symmetry++)
+        {
+            GameState transformed = transform_game_state(state, board_symmetry);
+            if (board_symmetry != 0)
+            {
+                consider(transformed, board_symmetry);
+            }
+            swap_neutral_pawns(transformed);
+            consider(transformed, board_symmetry + NUMBER_BOARD_SYMMETRIES);
+        }
+
+        // Inverse move-index map of the transformation.
+        std::fill(canonical.original_moves, canonical.original_moves + MAX_MVTS, -1);
+        int positions[4] = {(state.yellow_is_playing) ? state.yellow_position : state.red_position,
+                            state.black_position,
+                            state.white_position,
+                            state.orange_position};
+        for (int pawn = 0; pawn < 4; pawn++)
+        {
+            for (int index = 0; index < NODE_NEIGHBOURS_SIZE[positions[pawn]]; index++)
+            {
+                int move = pawn * MAX_MVT_PER_PAWN + index;
+                canonical.original_moves[transform_move(state, move, canonical.transformation)] = move;
+            }
+        }
+        canonical.original_moves[4 * MAX_MVT_PER_PAWN] = 4 * MAX_MVT_PER_PAWN;
+
+        return canonical;
+    }
+}
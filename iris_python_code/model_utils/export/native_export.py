@@ -0,0 +1,73 @@
+import struct
+import sys
+import torch
+
+# Export of the weights of an IrisZero model to the file format of the native C++ inference engine,
+# see 'iris_cpp_library/include/iris_zero/native_network.hpp'. The C++ 'load_model' recognizes these files
+# by their magic number, so the exported file can be used in place of a TorchScript file.
+
+NATIVE_MODEL_MAGIC = b"IRZN"
+NATIVE_MODEL_VERSION = 1
+
+
+def _write_tensor(file, tensor):
+    """
+    Writes a tensor as contiguous little-endian float32 values.
+    """
+    values = tensor.detach().to(torch.float32).contiguous().flatten().tolist()
+    file.write(struct.pack("<%df" % len(values), *values))
+
+
+def _write_linear(file, linear):
+    _write_tensor(file, linear.weight)
+    _write_tensor(file, linear.bias)
+
+
+def _write_convolution(file, conv, bnorm):
+    """
+    Writes a graph convolution followed by its BatchNorm layer (folded when the weights are loaded).
+    """
+    _write_linear(file, conv.fc)
+    _write_tensor(file, bnorm.weight)
+    _write_tensor(file, bnorm.bias)
+    _write_tensor(file, bnorm.running_mean)
+    _write_tensor(file, bnorm.running_var)
+    file.write(struct.pack("<f", getattr(bnorm, "eps", 1e-5)))
+
+
+def export_native(model, path):
+    """
+    Exports an IrisZero model (a 'torch.nn.Module' or a TorchScript module) to the native engine format.
+    """
+    res_blocks = list(model.res_blocks.children())
+    adjacency = model.initial_block.conv.normalized_adjacency_matrix
+    initial_fc = model.initial_block.conv.fc
+
+    num_nodes = adjacency.shape[0]
+    input_channels = initial_fc.weight.shape[1]
+    num_channels = initial_fc.weight.shape[0]
+    action_size = model.policy_head.fc.weight.shape[0]
+    num_head_filters = model.value_head.conv.fc.weight.shape[0]
+
+    with open(path, "wb") as file:
+        file.write(NATIVE_MODEL_MAGIC)
+        file.write(struct.pack("<7i", NATIVE_MODEL_VERSION, num_nodes, input_channels, num_channels, len(res_blocks), action_size, num_head_filters))
+
+        _write_tensor(file, adjacency)
+
+        _write_convolution(file, model.initial_block.conv, model.initial_block.bnorm)
+        for res_block in res_blocks:
+            _write_convolution(file, res_block.conv1, res_block.bnorm1)
+            _write_convolution(file, res_block.conv2, res_block.bnorm2)
+
+        _write_convolution(file, model.policy_head.conv, model.policy_head.bnorm)
+        _write_linear(file, model.policy_head.fc)
+
+        _write_convolution(file, model.value_head.conv, model.value_head.bnorm)
+        _write_linear(file, model.value_head.fc1)
+        _write_linear(file, model.value_head.fc2)
+
+
+if __name__ == "__main__":
+    # Usage: python -m iris_python_code.model_utils.export.native_export models/script/iris_weights.pt models/native/iris_weights.bin
+    export_native(torch.jit.load(sys.argv[1]), sys.argv[2])
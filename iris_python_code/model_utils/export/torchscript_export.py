@@ -0,0 +1,158 @@
+import sys
+import time
+import torch
+import torch.nn as nn
+import torch.nn.functional as F
+
+# Export of an IrisZero model to an inference-optimized TorchScript artifact for the C++ library.
+# The exported module computes the same function as 'IrisZero' in eval mode, with:
+# - the BatchNorm layers folded into the linear layer of the preceding graph convolution,
+# - the adjacency product computed as a single matmul over the node dimension, without expanding the adjacency
+#   matrix to the batch size and without the permutations around the BatchNorm layers,
+# - the rows of the linear layers of the heads reordered, so that their input is flattened node-major without permutation,
+# and is then frozen and optimized for inference.
+
+
+def fold_batchnorm(conv, bnorm):
+    """
+    Returns the (weight, bias) of the linear layer of a graph convolution followed by a BatchNorm layer in eval mode:
+    BN(Wx + b) = (s * W)x + s * (b - mean) + beta, with s = gamma / sqrt(var + eps).
+    """
+    scale = bnorm.weight / torch.sqrt(bnorm.running_var + bnorm.eps)
+    weight = conv.fc.weight * scale[:, None]
+    bias = scale * (conv.fc.bias - bnorm.running_mean) + bnorm.bias
+    return weight.detach().clone(), bias.detach().clone()
+
+
+def reorder_head_weight(weight, num_nodes, num_head_channels):
+    """
+    The heads flatten their (channel, node) features channel-major: returns the weight of the linear layer
+    reading the same features flattened node-major.
+    """
+    return weight.view(weight.size(0), num_head_channels, num_nodes).transpose(1, 2).reshape(weight.size(0), -1).detach().clone()
+
+
+class FusedGCNConv(nn.Module):
+    def __init__(self, weight, bias, normalized_adjacency_matrix):
+        super(FusedGCNConv, self).__init__()
+        self.weight = nn.Parameter(weight, requires_grad=False)
+        self.bias = nn.Parameter(bias, requires_grad=False)
+        self.register_buffer('normalized_adjacency_matrix', normalized_adjacency_matrix.detach().clone())
+
+    def forward(self, x):
+        # (N, N) @ (B, N, C) broadcasts over the batch.
+        return F.linear(torch.matmul(self.normalized_adjacency_matrix, x), self.weight, self.bias)
+
+
+class FusedResidualBlock(nn.Module):
+    def __init__(self, res_block, normalized_adjacency_matrix):
+        super(FusedResidualBlock, self).__init__()
+        self.conv1 = FusedGCNConv(*fold_batchnorm(res_block.conv1, res_block.bnorm1), normalized_adjacency_matrix)
+        self.conv2 = FusedGCNConv(*fold_batchnorm(res_block.conv2, res_block.bnorm2), normalized_adjacency_matrix)
+
+    def forward(self, x):
+        out = F.relu(self.conv1(x))
+        return F.relu(self.conv2(out) + x)
+
+
+class FusedIrisZero(nn.Module):
+    def __init__(self, model):
+        super(FusedIrisZero, self).__init__()
+        adjacency = model.initial_block.conv.normalized_adjacency_matrix
+        num_nodes = adjacency.shape[0]
+
+        self.initial_conv = FusedGCNConv(*fold_batchnorm(model.initial_block.conv, model.initial_block.bnorm), adjacency)
+        self.res_blocks = nn.ModuleList([FusedResidualBlock(res_block, adjacency) for res_block in model.res_blocks.children()])
+
+        self.policy_conv = FusedGCNConv(*fold_batchnorm(model.policy_head.conv, model.policy_head.bnorm), adjacency)
+        self.policy_fc = nn.Linear(1, 1)
+        self.policy_fc.weight = nn.Parameter(reorder_head_weight(model.policy_head.fc.weight, num_nodes, 2), requires_grad=False)
+        self.policy_fc.bias = nn.Parameter(model.policy_head.fc.bias.detach().clone(), requires_grad=False)
+
+        num_head_filters = model.value_head.conv.fc.weight.shape[0]
+        self.value_conv = FusedGCNConv(*fold_batchnorm(model.value_head.conv, model.value_head.bnorm), adjacency)
+        self.value_fc1 = nn.Linear(1, 1)
+        self.value_fc1.weight = nn.Parameter(reorder_head_weight(model.value_head.fc1.weight, num_nodes, num_head_filters), requires_grad=False)
+        self.value_fc1.bias = nn.Parameter(model.value_head.fc1.bias.detach().clone(), requires_grad=False)
+        self.value_fc2 = nn.Linear(1, 1)
+        self.value_fc2.weight = nn.Parameter(model.value_head.fc2.weight.detach().clone(), requires_grad=False)
+        self.value_fc2.bias = nn.Parameter(model.value_head.fc2.bias.detach().clone(), requires_grad=False)
+
+    def forward(self, x):
+        out = F.relu(self.initial_conv(x))
+        for res_block in self.res_blocks:
+            out = res_block(out)
+
+        policy = F.relu(self.policy_conv(out))
+        policy = self.policy_fc(policy.reshape(policy.size(0), -1))
+
+        value = F.relu(self.value_conv(out))
+        value = F.relu(self.value_fc1(value.reshape(value.size(0), -1)))
+        value = torch.tanh(self.value_fc2(value))
+        return policy, value
+
+
+def random_positions(num_positions, num_nodes, num_features):
+    """
+    Random inputs with the structure of encoded positions: one-hot pawn and tile columns, broadcast counters.
+    """
+    positions = torch.zeros((num_positions, num_nodes, num_features))
+    for k in range(5):
+        positions[torch.arange(num_positions), torch.randint(num_nodes, (num_positions,)), k] = 1.0
+    tiles = torch.randint(0, 6, (num_positions, num_nodes))
+    for k in range(5):
+        positions[:, :, 5 + k] = (tiles == k).float()
+    positions[:, :, 10:] = (torch.rand((num_positions, 1, num_features - 10)) < 0.3).float()
+    return positions
+
+
+def latency(model, positions, num_runs=200):
+    """
+    Mean latency of a forward pass, in microseconds.
+    """
+    with torch.no_grad():
+        for _ in range(10):
+            model(positions)
+        start = time.perf_counter()
+        for _ in range(num_runs):
+            model(positions)
+    return (time.perf_counter() - start) / num_runs * 1e6
+
+
+def export_torchscript(model, path, num_check_positions=1024, tolerance=1e-4):
+    """
+    Exports an IrisZero model (a 'torch.nn.Module' or a TorchScript module) to a frozen, inference-optimized
+    TorchScript file. Checks that the exported module gives the same outputs as the original one,
+    and reports the latency of both at batch sizes 1 and 64.
+    """
+    model.eval()
+    num_nodes = model.initial_block.conv.normalized_adjacency_matrix.shape[0]
+    num_features = model.initial_block.conv.fc.weight.shape[1]
+
+    fused_model = FusedIrisZero(model).eval()
+    exported_model = torch.jit.optimize_for_inference(torch.jit.freeze(torch.jit.script(fused_model)))
+
+    # Numerical equivalence.
+    positions = random_positions(num_check_positions, num_nodes, num_features)
+    with torch.no_grad():
+        policy, value = model(positions)
+        exported_policy, exported_value = exported_model(positions)
+    policy_error = (policy - exported_policy).abs().max().item()
+    value_error = (value - exported_value).abs().max().item()
+    print(f"Max abs difference: policy logits {policy_error:.2e}, value {value_error:.2e}")
+    if policy_error > tolerance or value_error > tolerance:
+        raise RuntimeError("The exported model does not match the original model")
+
+    # Latency.
+    for batch_size in (1, 64):
+        batch = positions[:batch_size]
+        original_latency = latency(model, batch)
+        exported_latency = latency(exported_model, batch)
+        print(f"Batch {batch_size}: {original_latency:.1f} us -> {exported_latency:.1f} us ({original_latency / exported_latency:.2f}x)")
+
+    exported_model.save(path)
+
+
+if __name__ == "__main__":
+    # Usage: python -m iris_python_code.model_utils.export.torchscript_export models/script/iris_weights.pt models/script/iris_weights_optimized.pt
+    export_torchscript(torch.jit.load(sys.argv[1]), sys.argv[2])
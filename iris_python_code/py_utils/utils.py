@@ -47,6 +47,7 @@ def launch_game(yellow_bot, red_bot, initial_state, max_turn=100):
     Play a game with functions representing players, taking an initial gamestate and returns the output of the game:
     1: Yellow victory, -1: Red victory, 0: draw (if the number of turns is above a max_turn parameter) and the number of
     turns in the game.
+    To evaluate C++ bots over many games, see py_iris.play_arena.
     """
     state = initial_state
     current_turn = 1
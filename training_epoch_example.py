@@ -59,9 +59,11 @@ def main():
 
     batch_size = 128
 
-    dataset = None # A dataset has to be generated, see the 'generate_training_sample' function in the 'iris_cpp_library/src/iris_zero.cpp' file.
+    dataset = None # A dataset has to be generated, see the 'generate_training_sample' function and the 'SelfPlayEngine' class in the 'iris_cpp_library/src/iris_zero_training.cpp' file.
     # Create a DataLoader on the dataset with data augmentation like rotations and symetries, see 'iris_python_code/model_utils/transformations/'.
     data_loader = DataLoader(dataset, batch_size=batch_size, collate_fn=transform_collate_fn)
+    # Self-play games written to shards can instead be sampled without a DataLoader, see the 'ReplayBuffer' class in the
+    # 'iris_cpp_library/src/replay_buffer.cpp' file, which also applies the random transformations natively : 'positions, policies, values = replay_buffer.sample()'.
     
     model.train()
 